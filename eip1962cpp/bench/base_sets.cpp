@@ -0,0 +1,41 @@
+#include "bench.h"
+#include "../src/base_sets.h"
+
+// Multiexp over a registered base set vs multiexp() on the same pairs, and the one off cost of building the set
+template <class S>
+void bench_base_sets_curve(S const &s, std::string const &group)
+{
+    std::mt19937_64 rng(9);
+    auto const scalar_bits = s.wc.order_len() * 8;
+    for (usize n : {16, 64, 128, 255})
+    {
+        auto const pairs = s.pairs(n, rng);
+        std::vector<typename std::decay<decltype(std::get<0>(pairs[0]))>::type> bases;
+        std::vector<std::vector<u64>> scalars;
+        for (auto const &[p, scalar] : pairs)
+        {
+            bases.push_back(p);
+            scalars.push_back(scalar);
+        }
+
+        auto const set = build_base_set(0, "", bases, scalar_bits, s.extension_degree, s.wc, s.context);
+        auto const expected = multiexp(pairs, s.wc, s.context, s.extension_degree).into_affine();
+        auto const got = base_set_multiexp(*set, scalars, s.wc, s.context).into_affine();
+        bench_check(expected.x == got.x && expected.y == got.y, group + " base set multiexp");
+
+        std::printf("%s %3u bases: c=%u%s, %lu bytes\n", group.c_str(), n, set->plan.window, set->plan.batch_affine ? " batch affine" : "", (unsigned long)set->bytes());
+        auto const plain = measure(stringf("%s %3u pairs multiexp", group.c_str(), n), [&]() { do_not_optimize(multiexp(pairs, s.wc, s.context, s.extension_degree)); }, 0.2);
+        auto const with_set = measure(stringf("%s %3u pairs base set multiexp", group.c_str(), n), [&]() { do_not_optimize(base_set_multiexp(*set, scalars, s.wc, s.context)); }, 0.2);
+        measure(stringf("%s %3u bases build", group.c_str(), n), [&]() { do_not_optimize(build_base_set(0, "", bases, scalar_bits, s.extension_degree, s.wc, s.context)); }, 0.2);
+        std::printf("%s %3u pairs: base set speedup %.2fx\n", group.c_str(), n, plain / with_set);
+    }
+}
+
+void bench_base_sets()
+{
+    bench_base_sets_curve(G1Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G1 multiplication: 2 bits")), "BN254 G1");
+    bench_base_sets_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "BLS12-381 G1 multiplication: 2 bits")), "BLS12-381 G1");
+    bench_base_sets_curve(G2Ext2Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G2 multiplication: 2 bits")), "BN254 G2");
+}
+
+BENCH_GROUP("base_sets", bench_base_sets)
@@ -0,0 +1,193 @@
+#ifndef H_BENCH
+#define H_BENCH
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <random>
+
+#include "../src/common.h"
+#include "../src/constants.h"
+#include "../src/deserialization.h"
+
+/*
+Minimal benchmark harness. Every benchmark group registers itself with BENCH_GROUP and is run by main,
+optionally filtered by a substring of the group name given as the first argument.
+
+Inputs are taken from the regression vectors in test_vectors, so benchmarks and tests run on the same curves.
+*/
+
+// Keeps the compiler from throwing away a computed value
+template <class T>
+inline void do_not_optimize(T const &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Runs f until at least min_seconds have passed and prints the mean time per call
+template <class F>
+double measure(std::string const &name, F f, double min_seconds = 0.3)
+{
+    using clock = std::chrono::steady_clock;
+
+    // warm up
+    f();
+
+    u64 iterations = 0;
+    u64 batch = 1;
+    auto const start = clock::now();
+    double elapsed = 0;
+    while (elapsed < min_seconds)
+    {
+        for (u64 i = 0; i < batch; i++)
+        {
+            f();
+        }
+        iterations += batch;
+        batch *= 2;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    auto const ns = elapsed * 1e9 / double(iterations);
+    std::printf("%-64s %14.0f ns/iter (%lu iterations)\n", name.c_str(), ns, (unsigned long)iterations);
+    return ns;
+}
+
+void inline bench_check(bool condition, std::string const &what)
+{
+    if (!condition)
+    {
+        std::printf("MISMATCH: %s\n", what.c_str());
+        std::exit(1);
+    }
+}
+
+// ********************** REGISTRY ********************** //
+
+std::vector<std::tuple<std::string, std::function<void()>>> &bench_groups();
+
+struct BenchRegistration
+{
+    BenchRegistration(std::string const &name, std::function<void()> f)
+    {
+        bench_groups().push_back(std::tuple(name, f));
+    }
+};
+
+#define BENCH_GROUP(NAME, FUNC) static BenchRegistration FUNC##_registration(NAME, FUNC);
+
+// ********************** INPUTS ********************** //
+
+std::vector<u8> inline from_hex(std::string const &hex)
+{
+    std::vector<u8> bytes;
+    for (usize i = 0; i + 1 < hex.size(); i += 2)
+    {
+        bytes.push_back(u8(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+// Input of the first vector with a given name in a test vector file
+std::vector<u8> inline vector_input(std::string const &path, std::string const &name)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto const sep = line.find('|');
+        if (sep != std::string::npos && line.substr(0, sep) == name)
+        {
+            auto const end = line.find('|', sep + 1);
+            return from_hex(line.substr(sep + 1, end - sep - 1));
+        }
+    }
+    std::printf("Test vector not found: %s\n", name.c_str());
+    std::exit(1);
+}
+
+// Random scalar below 2^bits(group order)
+std::vector<u64> inline random_scalar(std::vector<u64> const &order, std::mt19937_64 &rng)
+{
+    auto const bits = num_bits(order);
+    std::vector<u64> scalar((bits + 63) / 64, 0);
+    for (auto &limb : scalar)
+    {
+        limb = rng();
+    }
+    if (bits % 64 != 0)
+    {
+        scalar.back() &= (u64(1) << (bits % 64)) - 1;
+    }
+    return scalar;
+}
+
+// Context of the group from a G1 or G2 multiplication vector. N must leave a spare top bit
+// over the modulus, same as the limb count chosen in run_limbed.
+// F: Element, FE: field or extension the group is defined over
+template <usize N, class F, class FE>
+class GroupSetup
+{
+    std::vector<u8> const input;
+    Deserializer deserializer;
+    u8 const operation;
+
+public:
+    static constexpr u8 extension_degree = std::is_same<FE, PrimeField<N>>::value ? 1 : (std::is_same<FE, FieldExtension2<N>>::value ? 2 : 3);
+
+    u8 const mod_byte_len;
+    PrimeField<N> const field;
+    FE const context;
+    WeierstrassCurve<F> const wc;
+    AffinePoint<F> const generator;
+
+    GroupSetup(std::vector<u8> const &mul_input) : input(mul_input),
+                                                   deserializer(input),
+                                                   operation(deserializer.byte("operation")),
+                                                   mod_byte_len(deserializer.byte("modulus length")),
+                                                   field(deserialize_modulus<N>(mod_byte_len, deserializer)),
+                                                   context(extension(field)),
+                                                   wc(deserialize_weierstrass_curve<F>(mod_byte_len, context, deserializer, false)),
+                                                   generator(deserialize_curve_point<F>(mod_byte_len, context, wc, deserializer))
+    {
+    }
+
+    GroupSetup(GroupSetup const &) = delete;
+
+    // Random multiples of the generator with their scalars
+    std::vector<std::tuple<AffinePoint<F>, std::vector<u64>>> pairs(usize n, std::mt19937_64 &rng) const
+    {
+        std::vector<std::tuple<AffinePoint<F>, std::vector<u64>>> result;
+        for (usize i = 0; i < n; i++)
+        {
+            auto const p = generator.mul(random_scalar(wc.subgroup_order(), rng), wc, context).into_affine();
+            result.push_back(std::tuple(p, random_scalar(wc.subgroup_order(), rng)));
+        }
+        return result;
+    }
+
+private:
+    FE extension(PrimeField<N> const &field)
+    {
+        if constexpr (std::is_same<FE, PrimeField<N>>::value)
+        {
+            return field;
+        }
+        else
+        {
+            auto const degree = deserializer.byte("extension degree");
+            return FE(deserialize_non_residue<Fp<N>>(mod_byte_len, field, degree, deserializer), field, false);
+        }
+    }
+};
+
+template <usize N>
+using G1Setup = GroupSetup<N, Fp<N>, PrimeField<N>>;
+
+template <usize N>
+using G2Ext2Setup = GroupSetup<N, Fp2<N>, FieldExtension2<N>>;
+
+template <usize N>
+using G2Ext3Setup = GroupSetup<N, Fp3<N>, FieldExtension3<N>>;
+
+#endif
@@ -0,0 +1,66 @@
+#include "bench.h"
+#include "../src/multiexp.h"
+
+template <usize N>
+bool same_point(AffinePoint<Fp<N>> const &a, AffinePoint<Fp<N>> const &b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+// Jacobian vs complete projective formulas, on their own and as the Pippenger accumulator
+template <usize N>
+void bench_point_formulas(std::string const &curve)
+{
+    G1Setup<N> const s(vector_input("test_vectors/operations.txt", curve + " G1 multiplication: 2 bits"));
+    std::mt19937_64 rng(42);
+    auto const pairs = s.pairs(2, rng);
+    auto const p = std::get<0>(pairs[0]);
+    auto const q = std::get<0>(pairs[1]);
+
+    auto const jp = CurvePoint<Fp<N>>(p).mul(std::vector<u64>{3}, s.wc, s.context);
+    auto const jq = CurvePoint<Fp<N>>(q).mul(std::vector<u64>{5}, s.wc, s.context);
+    auto const pp = ProjectivePoint<Fp<N>>(p);
+    auto const pq = ProjectivePoint<Fp<N>>(q);
+
+    {
+        auto x = jp;
+        x.add(jq, s.wc, s.context);
+        auto y = pp;
+        y.add(pq, s.wc, s.context);
+        auto z = pp;
+        z.add(pp, s.wc, s.context);
+        auto w = pp;
+        w.mul2(s.wc);
+        bench_check(same_point(z.into_affine(), w.into_affine()), curve + " projective P+P == 2P");
+        auto v = pq;
+        v.add_mixed(p, s.wc, s.context);
+        bench_check(same_point(y.into_affine(), v.into_affine()), curve + " projective mixed addition");
+    }
+
+    measure(curve + " jacobian add", [&]() { auto x = jp; x.add(jq, s.wc, s.context); do_not_optimize(x); });
+    measure(curve + " projective add", [&]() { auto x = pp; x.add(pq, s.wc, s.context); do_not_optimize(x); });
+    measure(curve + " jacobian add_mixed", [&]() { auto x = jp; x.add_mixed(q, s.wc, s.context); do_not_optimize(x); });
+    measure(curve + " projective add_mixed", [&]() { auto x = pp; x.add_mixed(q, s.wc, s.context); do_not_optimize(x); });
+    measure(curve + " jacobian mul2", [&]() { auto x = jp; x.mul2(s.wc); do_not_optimize(x); });
+    measure(curve + " projective mul2", [&]() { auto x = pp; x.mul2(s.wc); do_not_optimize(x); });
+
+    for (usize n : {32, 128, 255})
+    {
+        auto const input = s.pairs(n, rng);
+        auto const window = pippenger_plan(n, max_scalar_bits(input), s.extension_degree, s.wc).window;
+        auto const expected = peepinger(input, s.wc, s.context, window).into_affine();
+        bench_check(same_point(expected, peepinger<ProjectivePoint>(input, s.wc, s.context, window).into_affine()), curve + " projective multiexp");
+
+        measure(stringf("%s multiexp %u jacobian", curve.c_str(), n), [&]() { do_not_optimize(peepinger(input, s.wc, s.context, window)); });
+        measure(stringf("%s multiexp %u projective", curve.c_str(), n), [&]() { do_not_optimize(peepinger<ProjectivePoint>(input, s.wc, s.context, window)); });
+    }
+}
+
+void bench_curve()
+{
+    bench_point_formulas<4>("BN254");
+    bench_point_formulas<6>("BLS12-381");
+    bench_point_formulas<6>("Generic");
+}
+
+BENCH_GROUP("curve", bench_curve)
@@ -0,0 +1,29 @@
+#include "bench.h"
+#include "../src/fixed_base.h"
+
+template <usize N>
+void bench_fixed_base_curve(std::string const &curve)
+{
+    G1Setup<N> const s(vector_input("test_vectors/operations.txt", curve + " G1 multiplication: 2 bits"));
+    std::mt19937_64 rng(42);
+    auto const scalar = random_scalar(s.wc.subgroup_order(), rng);
+    auto const scalar_bits = s.wc.order_len() * 8;
+
+    auto const table = build_fixed_base_table(s.generator, scalar_bits, FIXED_BASE_WINDOW, s.wc, s.context);
+    auto const expected = s.generator.mul(scalar, s.wc, s.context).into_affine();
+    auto const got = fixed_base_mul(*table, scalar, s.wc, s.context).into_affine();
+    bench_check(expected.x == got.x && expected.y == got.y, curve + " fixed base multiplication");
+
+    std::printf("%s table: %lu bytes\n", curve.c_str(), (unsigned long)table->bytes());
+    measure(curve + " mul", [&]() { do_not_optimize(s.generator.mul(scalar, s.wc, s.context)); });
+    measure(curve + " fixed base mul", [&]() { do_not_optimize(fixed_base_mul(*table, scalar, s.wc, s.context)); });
+    measure(curve + " fixed base table build", [&]() { do_not_optimize(build_fixed_base_table(s.generator, scalar_bits, FIXED_BASE_WINDOW, s.wc, s.context)); });
+}
+
+void bench_fixed_base()
+{
+    bench_fixed_base_curve<4>("BN254");
+    bench_fixed_base_curve<6>("BLS12-381");
+}
+
+BENCH_GROUP("fixed_base", bench_fixed_base)
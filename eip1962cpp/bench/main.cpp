@@ -0,0 +1,22 @@
+#include "bench.h"
+
+std::vector<std::tuple<std::string, std::function<void()>>> &bench_groups()
+{
+    static std::vector<std::tuple<std::string, std::function<void()>>> groups;
+    return groups;
+}
+
+int main(int argc, char **argv)
+{
+    std::string const filter = argc > 1 ? argv[1] : "";
+    for (auto const &[name, run] : bench_groups())
+    {
+        if (name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        std::printf("== %s\n", name.c_str());
+        run();
+    }
+    return 0;
+}
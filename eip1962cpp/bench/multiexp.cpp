@@ -0,0 +1,100 @@
+#include "bench.h"
+#include "../src/multiexp.h"
+
+// Straus with different windows vs Pippenger for small numbers of pairs, used to place the crossover in multiexp()
+template <class S>
+void bench_straus_curve(S const &s, std::string const &group)
+{
+    std::mt19937_64 rng(7);
+    for (usize n : {1, 2, 4, 8, 16, 32, 64, 128, 192, 255})
+    {
+        auto const pairs = s.pairs(n, rng);
+        auto const plan = pippenger_plan(n, max_scalar_bits(pairs), s.extension_degree, s.wc);
+        auto const expected = pippenger(pairs, s.wc, s.context, plan).into_affine();
+        for (usize straus_window : {3, 4, 5})
+        {
+            auto const got = straus(pairs, s.wc, s.context, straus_window).into_affine();
+            bench_check(expected.x == got.x && expected.y == got.y, group + " straus");
+        }
+
+        measure(stringf("%s %2u pairs pippenger", group.c_str(), n), [&]() { do_not_optimize(pippenger(pairs, s.wc, s.context, plan)); }, 0.1);
+        for (usize straus_window : {3, 4, 5})
+        {
+            measure(stringf("%s %2u pairs straus w=%u", group.c_str(), n, straus_window), [&]() { do_not_optimize(straus(pairs, s.wc, s.context, straus_window)); }, 0.1);
+        }
+    }
+}
+
+void bench_straus()
+{
+    bench_straus_curve(G1Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G1 multiplication: 2 bits")), "BN254 G1");
+    bench_straus_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "BLS12-381 G1 multiplication: 2 bits")), "BLS12-381 G1");
+    bench_straus_curve(G2Ext2Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G2 multiplication: 2 bits")), "BN254 G2");
+    bench_straus_curve(G2Ext3Setup<6>(vector_input("test_vectors/operations.txt", "Generic G2 ext3 multiplication: 2 bits")), "Generic G2 ext3");
+}
+
+BENCH_GROUP("straus", bench_straus)
+
+// Large multiexp in chunks of MULTIEXP_STREAM_CHUNK pairs vs Pippenger over all pairs at once
+template <class S>
+void bench_multiexp_stream_curve(S const &s, std::string const &group)
+{
+    std::mt19937_64 rng(11);
+    for (usize n : {2048, 8192})
+    {
+        auto const pairs = s.pairs(n, rng);
+        auto const plan = pippenger_plan(n, max_scalar_bits(pairs), s.extension_degree, s.wc);
+        auto const stream = [&]() {
+            usize next = 0;
+            return streaming_multiexp(n, [&]() { return pairs[next++]; }, s.wc, s.context, s.extension_degree);
+        };
+
+        auto const expected = pippenger(pairs, s.wc, s.context, plan).into_affine();
+        auto const got = stream().into_affine();
+        bench_check(expected.x == got.x && expected.y == got.y, group + " streaming multiexp");
+
+        measure(stringf("%s %4u pairs pippenger c=%u", group.c_str(), n, plan.window), [&]() { do_not_optimize(pippenger(pairs, s.wc, s.context, plan)); }, 0.5);
+        measure(stringf("%s %4u pairs streaming", group.c_str(), n), [&]() { do_not_optimize(stream()); }, 0.5);
+    }
+}
+
+void bench_multiexp_stream()
+{
+    bench_multiexp_stream_curve(G1Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G1 multiplication: 2 bits")), "BN254 G1");
+    bench_multiexp_stream_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "BLS12-381 G1 multiplication: 2 bits")), "BLS12-381 G1");
+}
+
+BENCH_GROUP("multiexp_stream", bench_multiexp_stream)
+
+// multiexp() with and without the endomorphism split, and the split alone
+template <class S>
+void bench_multiexp_endomorphism_curve(S const &s, std::string const &group)
+{
+    std::mt19937_64 rng(13);
+    auto &enabled = EndomorphismSettings::getInstance().enabled;
+    for (usize n : {255, 512, 1024, 2048})
+    {
+        auto const pairs = s.pairs(n, rng);
+
+        enabled = false;
+        auto const expected = multiexp(pairs, s.wc, s.context, s.extension_degree).into_affine();
+        measure(stringf("%s %4u pairs multiexp", group.c_str(), n), [&]() { do_not_optimize(multiexp(pairs, s.wc, s.context, s.extension_degree)); }, 0.5);
+
+        enabled = true;
+        auto const got = multiexp(pairs, s.wc, s.context, s.extension_degree).into_affine();
+        bench_check(expected.x == got.x && expected.y == got.y, group + " endomorphism split");
+        measure(stringf("%s %4u pairs multiexp with split", group.c_str(), n), [&]() { do_not_optimize(multiexp(pairs, s.wc, s.context, s.extension_degree)); }, 0.5);
+        enabled = false;
+
+        auto split = pairs;
+        measure(stringf("%s %4u pairs split", group.c_str(), n), [&]() { do_not_optimize(endomorphism_split(pairs, s.wc, s.context, split)); }, 0.1);
+    }
+}
+
+void bench_multiexp_endomorphism()
+{
+    bench_multiexp_endomorphism_curve(G1Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G1 multiplication: 2 bits")), "BN254 G1");
+    bench_multiexp_endomorphism_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "BLS12-381 G1 multiplication: 2 bits")), "BLS12-381 G1");
+}
+
+BENCH_GROUP("multiexp_endomorphism", bench_multiexp_endomorphism)
@@ -0,0 +1,77 @@
+#include "bench.h"
+#include "../src/api.h"
+
+// Whole pairing calls through the API, with G2 line coefficients prepared on every call and taken from the line cache
+void bench_pairing_line_cache_vector(std::string const &name)
+{
+    auto const input = vector_input("test_vectors/pairings.txt", name);
+    auto const expected = std::get<0>(run(input));
+
+    configure_pairing_line_cache(0);
+    auto const uncached = measure(name + " prepared", [&]() { do_not_optimize(run(input)); });
+    configure_pairing_line_cache(LINE_CACHE_MAX_BYTES);
+    bench_check(std::get<0>(run(input)) == expected, name + " cached lines");
+    auto const cached = measure(name + " cached lines", [&]() { do_not_optimize(run(input)); });
+    std::printf("%s: line cache speedup %.2fx\n", name.c_str(), uncached / cached);
+}
+
+void bench_pairing_line_cache()
+{
+    bench_pairing_line_cache_vector("BN254 pairing: e(2P,3Q)*e(-6P,Q)");
+    bench_pairing_line_cache_vector("BLS12-381 pairing: e(3P,2Q)*e(-2P,3Q)");
+}
+
+BENCH_GROUP("pairing_line_cache", bench_pairing_line_cache)
+
+// 8 pair pairings with the pairs split over 1, 2 and 4 threads
+void bench_pairing_threads_vector(std::string const &name)
+{
+    auto const input = vector_input("test_vectors/pairings.txt", name);
+    auto const expected = std::get<0>(run(input));
+
+    configure_parallel_pairing(true);
+    for (usize threads : {1, 2, 4})
+    {
+        configure_threads(threads);
+        bench_check(std::get<0>(run(input)) == expected, name + " parallel");
+        measure(stringf("%s, %u threads", name.c_str(), threads), [&]() { do_not_optimize(run(input)); });
+    }
+    configure_threads(1);
+    configure_parallel_pairing(false);
+}
+
+void bench_pairing_threads()
+{
+    bench_pairing_threads_vector("BN254 pairing: 8 pairs");
+    bench_pairing_threads_vector("BLS12-381 pairing: 8 pairs");
+}
+
+BENCH_GROUP("pairing_threads", bench_pairing_threads)
+
+// 16 copies of a 2 pair check one by one and in one batch with a single final exponentiation
+void bench_pairing_batch_vector(std::string const &name)
+{
+    auto const input = vector_input("test_vectors/pairings.txt", name);
+    std::vector<std::vector<std::uint8_t>> const inputs(16, input);
+
+    auto const alone = measure(name + ", 16 checks alone", [&]() {
+        for (auto const &check : inputs)
+        {
+            do_not_optimize(run(check));
+        }
+    });
+    for (auto const &result : run_pairing_batch(inputs))
+    {
+        bench_check(result == run(input), name + " batch");
+    }
+    auto const batched = measure(name + ", 16 checks batched", [&]() { do_not_optimize(run_pairing_batch(inputs)); });
+    std::printf("%s: batch speedup %.2fx\n", name.c_str(), alone / batched);
+}
+
+void bench_pairing_batch()
+{
+    bench_pairing_batch_vector("BN254 pairing: e(2P,3Q)*e(-6P,Q)");
+    bench_pairing_batch_vector("BLS12-381 pairing: e(3P,2Q)*e(-2P,3Q)");
+}
+
+BENCH_GROUP("pairing_batch", bench_pairing_batch)
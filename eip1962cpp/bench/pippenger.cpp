@@ -0,0 +1,309 @@
+#include <array>
+#include <utility>
+
+#include "bench.h"
+#include "../src/multiexp.h"
+
+// ********************** COST CALIBRATION ********************** //
+
+// Operation counts do not depend on the points being on the curve, so the costs are measured
+// on random coordinates over a random odd modulus of every limb count.
+
+template <usize N>
+Fp<N> random_fp(PrimeField<N> const &field, std::mt19937_64 &rng)
+{
+    Repr<N> repr;
+    for (usize i = 0; i < N; i++)
+    {
+        repr[i] = rng();
+    }
+    repr[N - 1] >>= 4;
+    return Fp<N>(repr, field);
+}
+
+template <usize N>
+Fp<N> random_element(PrimeField<N> const &field, std::mt19937_64 &rng)
+{
+    return random_fp(field, rng);
+}
+
+template <usize N>
+Fp2<N> random_element(FieldExtension2<N> const &field, std::mt19937_64 &rng)
+{
+    return Fp2<N>(random_fp<N>(field, rng), random_fp<N>(field, rng), field);
+}
+
+template <usize N>
+Fp3<N> random_element(FieldExtension3<N> const &field, std::mt19937_64 &rng)
+{
+    return Fp3<N>(random_fp<N>(field, rng), random_fp<N>(field, rng), random_fp<N>(field, rng), field);
+}
+
+// E: Element, C: field or extension
+template <class E, class C>
+PointCosts measure_point_costs(C const &context, bool a_is_zero, std::string const &name, std::mt19937_64 &rng)
+{
+    auto const a = a_is_zero ? E::zero(context) : random_element(context, rng);
+    WeierstrassCurve<E> const wc(a, random_element(context, rng), std::vector<u64>{1}, 1);
+
+    AffinePoint<E> const p(random_element(context, rng), random_element(context, rng));
+    AffinePoint<E> const q(random_element(context, rng), random_element(context, rng));
+    auto jp = CurvePoint<E>(p);
+    jp.add_mixed(q, wc, context);
+    auto jq = CurvePoint<E>(q);
+    jq.mul2(wc);
+    auto const element = random_element(context, rng);
+
+    usize const batch = 256;
+    std::vector<AffinePoint<E>> targets;
+    std::vector<AffinePoint<E>> sources;
+    for (usize i = 0; i < batch; i++)
+    {
+        targets.push_back(AffinePoint<E>(random_element(context, rng), random_element(context, rng)));
+        sources.push_back(AffinePoint<E>(random_element(context, rng), random_element(context, rng)));
+    }
+    BatchAffineAdder<E> adder;
+    auto batch_add = [&]() {
+        auto points = targets;
+        for (usize i = 0; i < batch; i++)
+        {
+            adder.add(points[i], sources[i], wc);
+        }
+        adder.run();
+        do_not_optimize(points);
+    };
+
+    // Fastest of a few interleaved rounds, so that a noisy round does not skew a ratio
+    double const seconds = 0.02;
+    std::array<double, 5> best;
+    for (usize round = 0; round < 5; round++)
+    {
+        std::array<double, 5> const ns = {
+            measure(name + " add_mixed", [&]() { auto r = jp; r.add_mixed(q, wc, context); do_not_optimize(r); }, seconds),
+            measure(name + " add", [&]() { auto r = jp; r.add(jq, wc, context); do_not_optimize(r); }, seconds),
+            measure(name + " mul2", [&]() { auto r = jp; r.mul2(wc); do_not_optimize(r); }, seconds),
+            measure(stringf("%s batch of %u affine additions", name.c_str(), batch), batch_add, seconds),
+            measure(name + " inverse", [&]() { do_not_optimize(element.inverse()); }, seconds),
+        };
+        for (usize i = 0; i < ns.size(); i++)
+        {
+            best[i] = round == 0 ? ns[i] : std::min(best[i], ns[i]);
+        }
+    }
+
+    auto const mixed = best[0];
+    return PointCosts{best[1] / mixed, best[2] / mixed, (best[3] - best[4]) / double(batch) / mixed, best[4] / mixed};
+}
+
+template <usize N>
+void calibrate_limbs(std::vector<std::string> &rows, std::mt19937_64 &rng)
+{
+    Repr<N> modulus;
+    for (usize i = 0; i < N; i++)
+    {
+        modulus[i] = rng();
+    }
+    modulus[0] |= 1;
+    modulus[N - 1] >>= 2;
+    PrimeField<N> const field(modulus);
+    FieldExtension2<N> const ext2(random_fp(field, rng), field, false);
+    FieldExtension3<N> const ext3(random_fp(field, rng), field, false);
+
+    for (bool a_is_zero : {true, false})
+    {
+        auto const name = stringf("N=%u %s", N, a_is_zero ? "a=0" : "a!=0");
+        std::array<PointCosts, 3> const costs = {
+            measure_point_costs<Fp<N>>(field, a_is_zero, name + " Fp", rng),
+            measure_point_costs<Fp2<N>>(ext2, a_is_zero, name + " Fp2", rng),
+            measure_point_costs<Fp3<N>>(ext3, a_is_zero, name + " Fp3", rng),
+        };
+        std::string row = stringf("    {%2u, %d, {", N, a_is_zero ? 1 : 0);
+        for (usize i = 0; i < costs.size(); i++)
+        {
+            row += stringf("%s{%.2f, %.2f, %.2f, %.1f}", i == 0 ? "" : ", ", costs[i].add, costs[i].mul2, costs[i].batch_add, costs[i].inverse);
+        }
+        rows.push_back(row + "}},");
+    }
+}
+
+template <usize... N>
+void calibrate_all(std::index_sequence<N...>)
+{
+    std::mt19937_64 rng(11);
+    std::vector<std::string> rows;
+    (calibrate_limbs<N + 4>(rows, rng), ...);
+
+    std::printf("\nPIPPENGER_COSTS for src/pippenger_costs.h:\n");
+    for (auto const &row : rows)
+    {
+        std::printf("%s\n", row.c_str());
+    }
+}
+
+void bench_pippenger_costs()
+{
+    calibrate_all(std::make_index_sequence<13>());
+}
+
+BENCH_GROUP("pippenger_costs", bench_pippenger_costs)
+
+// ********************** WINDOW CHOICE ********************** //
+
+// Pippenger at every window, with Jacobian and batch affine buckets, vs the plan picked by the cost model
+template <class S>
+void bench_pippenger_window_curve(S const &s, std::string const &group)
+{
+    std::mt19937_64 rng(5);
+    for (usize n : {32, 64, 128, 255})
+    {
+        auto const pairs = s.pairs(n, rng);
+        auto const expected = straus(pairs, s.wc, s.context, 4).into_affine();
+        auto const scalar_bits = max_scalar_bits(pairs);
+        auto const chosen = pippenger_plan(n, scalar_bits, s.extension_degree, s.wc);
+
+        PippengerPlan best{0, false};
+        double best_ns = 0;
+        for (usize window = 2; window <= 10; window++)
+        {
+            for (bool batch_affine : {false, true})
+            {
+                auto const run = [&]() {
+                    return batch_affine ? batch_affine_pippenger(pairs, s.wc, s.context, window) : peepinger(pairs, s.wc, s.context, window);
+                };
+                auto const got = run().into_affine();
+                bench_check(expected.x == got.x && expected.y == got.y, group + " pippenger");
+
+                auto const is_chosen = window == chosen.window && batch_affine == chosen.batch_affine;
+                auto const ns = measure(stringf("%s %3u pairs c=%2u %s%s", group.c_str(), n, window, batch_affine ? "batch affine" : "jacobian", is_chosen ? " (chosen)" : ""), [&]() { do_not_optimize(run()); }, 0.1);
+                if (best.window == 0 || ns < best_ns)
+                {
+                    best = PippengerPlan{window, batch_affine};
+                    best_ns = ns;
+                }
+            }
+        }
+        std::printf("%s %3u pairs: chosen c=%u%s, fastest c=%u%s\n", group.c_str(), n, chosen.window, chosen.batch_affine ? " batch affine" : "", best.window, best.batch_affine ? " batch affine" : "");
+    }
+}
+
+void bench_pippenger_window()
+{
+    bench_pippenger_window_curve(G1Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G1 multiplication: 2 bits")), "BN254 G1");
+    bench_pippenger_window_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "BLS12-381 G1 multiplication: 2 bits")), "BLS12-381 G1");
+    bench_pippenger_window_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "Generic G1 multiplication: 2 bits")), "Generic G1");
+    bench_pippenger_window_curve(G2Ext2Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G2 multiplication: 2 bits")), "BN254 G2");
+    bench_pippenger_window_curve(G2Ext3Setup<6>(vector_input("test_vectors/operations.txt", "Generic G2 ext3 multiplication: 2 bits")), "Generic G2 ext3");
+}
+
+BENCH_GROUP("pippenger_window", bench_pippenger_window)
+
+// ********************** SIGNED DIGITS ********************** //
+
+// Pippenger with unsigned digits and 2^c - 1 buckets per window, as before signed digits
+template <class E, class C>
+CurvePoint<E> unsigned_pippenger(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> pairs, WeierstrassCurve<E> const &wc, C const &context, usize c)
+{
+    auto const scalar_bits = max_scalar_bits(pairs);
+    u64 const mask = (u64(1) << c) - 1;
+    std::vector<CurvePoint<E>> windows;
+    std::vector<CurvePoint<E>> buckets;
+
+    for (usize cur = 0; cur < scalar_bits; cur += c)
+    {
+        buckets.assign(mask, CurvePoint<E>::zero(context));
+        for (auto &[g, s] : pairs)
+        {
+            auto const index = s[0] & mask;
+            if (index != 0)
+            {
+                buckets[index - 1].add_mixed(g, wc, context);
+            }
+            right_shift(s, c);
+        }
+
+        auto acc = CurvePoint<E>::zero(context);
+        auto running_sum = CurvePoint<E>::zero(context);
+        for (auto it = buckets.crbegin(); it != buckets.crend(); it++)
+        {
+            running_sum.add(*it, wc, context);
+            acc.add(running_sum, wc, context);
+        }
+        windows.push_back(acc);
+    }
+
+    auto acc = CurvePoint<E>::zero(context);
+    for (auto it = windows.crbegin(); it != windows.crend(); it++)
+    {
+        for (usize i = 0; i < c; i++)
+        {
+            acc.mul2(wc);
+        }
+        acc.add(*it, wc, context);
+    }
+    return acc;
+}
+
+template <class S>
+void bench_pippenger_signed_curve(S const &s, std::string const &group)
+{
+    std::mt19937_64 rng(3);
+    for (usize n : {128, 255})
+    {
+        auto const pairs = s.pairs(n, rng);
+        auto const expected = unsigned_pippenger(pairs, s.wc, s.context, 5).into_affine();
+        for (usize window : {4, 5, 6, 7})
+        {
+            auto const got = peepinger(pairs, s.wc, s.context, window).into_affine();
+            bench_check(expected.x == got.x && expected.y == got.y, group + " signed pippenger");
+
+            measure(stringf("%s %3u pairs c=%u unsigned", group.c_str(), n, window), [&]() { do_not_optimize(unsigned_pippenger(pairs, s.wc, s.context, window)); }, 0.2);
+            measure(stringf("%s %3u pairs c=%u signed", group.c_str(), n, window), [&]() { do_not_optimize(peepinger(pairs, s.wc, s.context, window)); }, 0.2);
+        }
+    }
+}
+
+void bench_pippenger_signed()
+{
+    bench_pippenger_signed_curve(G1Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G1 multiplication: 2 bits")), "BN254 G1");
+    bench_pippenger_signed_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "BLS12-381 G1 multiplication: 2 bits")), "BLS12-381 G1");
+    bench_pippenger_signed_curve(G2Ext2Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G2 multiplication: 2 bits")), "BN254 G2");
+    bench_pippenger_signed_curve(G2Ext3Setup<6>(vector_input("test_vectors/operations.txt", "Generic G2 ext3 multiplication: 2 bits")), "Generic G2 ext3");
+}
+
+BENCH_GROUP("pippenger_signed", bench_pippenger_signed)
+
+// ********************** THREADS ********************** //
+
+// Pippenger with the chosen plan on 1, 2 and 4 threads, every thread count must give the serial result
+template <class S>
+void bench_pippenger_threads_curve(S const &s, std::string const &group)
+{
+    auto &pool = ThreadPool::getInstance();
+    std::mt19937_64 rng(7);
+    for (usize n : {128, 255})
+    {
+        auto const pairs = s.pairs(n, rng);
+        auto const plan = pippenger_plan(n, max_scalar_bits(pairs), s.extension_degree, s.wc);
+
+        pool.set_threads(1);
+        auto const expected = pippenger(pairs, s.wc, s.context, plan).into_affine();
+        for (usize threads : {1, 2, 4})
+        {
+            pool.set_threads(threads);
+            auto const got = pippenger(pairs, s.wc, s.context, plan).into_affine();
+            bench_check(expected.x == got.x && expected.y == got.y, group + " parallel pippenger");
+
+            measure(stringf("%s %3u pairs c=%u%s, %u threads", group.c_str(), n, plan.window, plan.batch_affine ? " batch affine" : "", threads), [&]() { do_not_optimize(pippenger(pairs, s.wc, s.context, plan)); }, 0.2);
+        }
+    }
+    pool.set_threads(1);
+}
+
+void bench_pippenger_threads()
+{
+    bench_pippenger_threads_curve(G1Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G1 multiplication: 2 bits")), "BN254 G1");
+    bench_pippenger_threads_curve(G1Setup<6>(vector_input("test_vectors/operations.txt", "BLS12-381 G1 multiplication: 2 bits")), "BLS12-381 G1");
+    bench_pippenger_threads_curve(G2Ext2Setup<4>(vector_input("test_vectors/operations.txt", "BN254 G2 multiplication: 2 bits")), "BN254 G2");
+}
+
+BENCH_GROUP("pippenger_threads", bench_pippenger_threads)
@@ -3,11 +3,14 @@
 #include "deserialization.h"
 #include "repr.h"
 #include "multiexp.h"
+#include "fixed_base.h"
+#include "base_sets.h"
 #include "extension_towers/fp4.h"
 #include "pairings/mnt4.h"
 #include "pairings/mnt6.h"
 #include "pairings/bn.h"
 #include "pairings/bls12.h"
+#include "pairings/batch.h"
 
 /*
 Execution path goes run -> run_limbed -> run_operation -> {run_pairing_mnt,run_pairing_b,run_operation_extension}
@@ -36,7 +39,7 @@ std::vector<std::uint8_t> run_operation_extension(u8 operation, u8 mod_byte_len,
     case OPERATION_G2_ADD:
     {
         // deser CurvePoints to be added
-        auto p_0 = deserialize_curve_point<F>(mod_byte_len, extension, wc, deserializer);
+        auto p_0 = CurvePoint<F>(deserialize_curve_point<F>(mod_byte_len, extension, wc, deserializer));
         auto const p_1 = deserialize_curve_point<F>(mod_byte_len, extension, wc, deserializer);
 
         if (!deserializer.ended()) {
@@ -44,7 +47,7 @@ std::vector<std::uint8_t> run_operation_extension(u8 operation, u8 mod_byte_len,
         }
 
         // Apply addition
-        p_0.add(p_1, wc, extension);
+        p_0.add_mixed(p_1, wc, extension);
 
         // seri Result
         p_0.serialize(mod_byte_len, result);
@@ -54,16 +57,17 @@ std::vector<std::uint8_t> run_operation_extension(u8 operation, u8 mod_byte_len,
     case OPERATION_G1_MUL:
     case OPERATION_G2_MUL:
     {
-        // deser CurvePoint & Scalar
+        // deser AffinePoint & Scalar, everything before the scalar identifies the base
         auto const p_0 = deserialize_curve_point<F>(mod_byte_len, extension, wc, deserializer);
+        auto const base_key = std::string(1, char(operation)) + deserializer.consumed();
         auto const scalar = deserialize_scalar(wc, deserializer);
 
         if (!deserializer.ended()) {
             input_err("Input contains garbage at the end");  
         }
 
-        // Apply multiplication
-        auto r = p_0.mul(scalar, wc, extension);
+        // Apply multiplication, through precomputed tables for repeated bases
+        auto r = cached_mul(base_key, p_0, scalar, wc, extension);
 
         // seri Result
         r.serialize(mod_byte_len, result);
@@ -73,7 +77,7 @@ std::vector<std::uint8_t> run_operation_extension(u8 operation, u8 mod_byte_len,
     case OPERATION_G1_MULTIEXP:
     case OPERATION_G2_MULTIEXP:
     {
-        // deser (CurvePoint,Scalar) pairs
+        // deser (AffinePoint,Scalar) pairs
         auto const num_pairs = deserializer.byte("Input is not long enough to get number of pairs");
         if (num_pairs == 0)
         {
@@ -87,14 +91,14 @@ std::vector<std::uint8_t> run_operation_extension(u8 operation, u8 mod_byte_len,
             input_err("Input length is invalid for number of pairs");
         }
 
-        std::vector<std::tuple<CurvePoint<F>, std::vector<u64>>> pairs;
+        std::vector<std::tuple<AffinePoint<F>, std::vector<u64>>> pairs;
         pairs.reserve(num_pairs);
 
         for (auto i = 0; i < num_pairs; i++)
         {
             auto const p = deserialize_curve_point<F>(mod_byte_len, extension, wc, deserializer);
-            auto const scalar = deserialize_scalar(wc, deserializer);
-            pairs.push_back(tuple(p, scalar));
+            auto scalar = deserialize_scalar(wc, deserializer);
+            pairs.emplace_back(p, std::move(scalar));
         }
 
         if (!deserializer.ended()) {
@@ -102,7 +106,99 @@ std::vector<std::uint8_t> run_operation_extension(u8 operation, u8 mod_byte_len,
         }
 
         // Apply Multiexponentiation
-        auto const r = peepinger(pairs, wc, extension);
+        auto const r = multiexp(pairs, wc, extension, extension_degree);
+
+        // seri Result
+        r.serialize(mod_byte_len, result);
+        break;
+    }
+    // Multiexp with a 4 byte number of pairs, decoded and computed in chunks
+    case OPERATION_G1_LARGE_MULTIEXP:
+    case OPERATION_G2_LARGE_MULTIEXP:
+    {
+        auto const num_pairs = deserializer.number<1>(4, "Input is not long enough to get number of pairs")[0];
+        if (num_pairs == 0)
+        {
+            input_err("Invalid number of pairs");
+        }
+
+        u64 const expected_pair_len = u64(2) * u64(extension_degree) * u64(mod_byte_len) + u64(wc.order_len());
+        if (u64(deserializer.remaining()) != expected_pair_len * num_pairs)
+        {
+            input_err("Input length is invalid for number of pairs");
+        }
+
+        auto const next_pair = [&]() {
+            auto const p = deserialize_curve_point<F>(mod_byte_len, extension, wc, deserializer);
+            return std::tuple(p, deserialize_scalar(wc, deserializer));
+        };
+        auto const r = streaming_multiexp(num_pairs, next_pair, wc, extension, extension_degree);
+
+        // seri Result
+        r.serialize(mod_byte_len, result);
+        break;
+    }
+    // Base set registration, multiexp input without scalars
+    case OPERATION_G1_REGISTER_BASES:
+    case OPERATION_G2_REGISTER_BASES:
+    {
+        // Everything between the operation and the number of points decodes the curve of the set
+        auto const curve = deserializer.consumed().substr(OPERATION_ENCODING_LENGTH);
+
+        auto const num_points = deserializer.byte("Input is not long enough to get number of points");
+        if (num_points == 0)
+        {
+            input_err("Invalid number of points");
+        }
+
+        u32 const expected_point_len = u32(2) * u32(extension_degree) * u32(mod_byte_len);
+        if (deserializer.remaining() != expected_point_len * num_points)
+        {
+            input_err("Input length is invalid for number of points");
+        }
+
+        std::vector<AffinePoint<F>> bases;
+        bases.reserve(num_points);
+        for (auto i = 0; i < num_points; i++)
+        {
+            bases.push_back(deserialize_curve_point<F>(mod_byte_len, extension, wc, deserializer));
+        }
+
+        auto const with_bases = operation == OPERATION_G1_REGISTER_BASES ? OPERATION_G1_MULTIEXP_WITH_BASES : OPERATION_G2_MULTIEXP_WITH_BASES;
+        auto const set = build_base_set(with_bases, curve, bases, usize(wc.order_len()) * 8, extension_degree, wc, extension);
+        auto const handle = MultiexpBaseSets::getInstance().add(set);
+
+        // Handle in big endian
+        for (usize i = 8; i-- > 0;)
+        {
+            result.push_back(u8(handle >> (8 * i)));
+        }
+        break;
+    }
+    // Multiexp over a registered base set, the curve of the set is followed by the handle and the scalars
+    case OPERATION_G1_MULTIEXP_WITH_BASES:
+    case OPERATION_G2_MULTIEXP_WITH_BASES:
+    {
+        auto const handle = deserializer.number<1>(8, "Input is not long enough to get base set handle")[0];
+        auto const set = MultiexpBaseSets::getInstance().sets.get(MultiexpBaseSets::key(handle));
+        if (!set)
+        {
+            input_err("Unknown base set handle");
+        }
+
+        if (deserializer.remaining() != u32(wc.order_len()) * set->points)
+        {
+            input_err("Input length is invalid for number of points");
+        }
+
+        std::vector<std::vector<u64>> scalars;
+        scalars.reserve(set->points);
+        for (usize i = 0; i < set->points; i++)
+        {
+            scalars.push_back(deserialize_scalar(wc, deserializer));
+        }
+
+        auto const r = base_set_multiexp(*set, scalars, wc, extension);
 
         // seri Result
         r.serialize(mod_byte_len, result);
@@ -117,8 +213,48 @@ std::vector<std::uint8_t> run_operation_extension(u8 operation, u8 mod_byte_len,
     return result;
 }
 
+// Multiplies the Miller values of the batch members with the parameters of the decoded input into f, each raised to
+// a random weight, and gives their verdicts. See pairings/batch.h.
+template <class ENGINE, usize N>
+void batch_miller_values(ENGINE const &engine, std::string const &key, u8 mod_byte_len, FieldExtension2<N> const &extension2, FieldExtension2over3over2<N> const &extension12, WeierstrassCurve<Fp<N>> const &g1_curve, WeierstrassCurve<Fp2<N>> const &g2_curve, Fp12<N> &f, PairingBatch &batch)
+{
+    std::random_device random;
+    std::vector<Fp12<N>> values;
+    std::vector<u64> weights;
+    for (usize i = 0; i < batch.members.size(); i++)
+    {
+        auto const &input = batch.inputs[batch.members[i]];
+        if (input.size() < key.size() || std::string(input.cbegin(), input.cbegin() + key.size()) != key)
+        {
+            continue;
+        }
+        batch.verdicts[i] = BATCH_RUN_ALONE;
+        try
+        {
+            auto deserializer = Deserializer(input);
+            deserializer.advance(key.size(), "Input is not long enough to get pairing parameters");
+            auto const points = deserialize_points<N, Fp2<N>>(mod_byte_len, extension2, g1_curve, g2_curve, deserializer);
+            if (!deserializer.ended() || points.size() == 0)
+            {
+                continue;
+            }
+            values.push_back(engine.miller_value(points, extension12));
+            weights.push_back(batch_weight(random));
+            batch.verdicts[i] = BATCH_VERIFIED;
+        }
+        catch (std::domain_error const &)
+        {
+            // Runs alone to give the error
+        }
+        catch (std::runtime_error const &)
+        {
+        }
+    }
+    f.mul(weighted_product(values, weights, Fp12<N>::one(extension12)));
+}
+
 template <class ENGINE, usize N>
-std::vector<std::uint8_t> run_pairing_b(u8 mod_byte_len, PrimeField<N> const &field, usize max_u_bit_length, Deserializer deserializer)
+std::vector<std::uint8_t> run_pairing_b(u8 mod_byte_len, PrimeField<N> const &field, usize max_u_bit_length, Deserializer deserializer, PairingBatch *batch)
 {
     // Deser Weierstrass 1 & Extension2
     auto const g1_curve = deserialize_weierstrass_curve<Fp<N>>(mod_byte_len, field, deserializer, true);
@@ -175,7 +311,10 @@ std::vector<std::uint8_t> run_pairing_b(u8 mod_byte_len, PrimeField<N> const &fi
     }
     auto const u_is_negative = deserialize_sign(deserializer);
 
-    // deser (CurvePoint<Fp<N>>,CurvePoint<F>) pairs
+    // Everything up to here defines the prepared lines of a G2 point
+    auto const line_cache_key = deserializer.consumed();
+
+    // deser (AffinePoint<Fp<N>>,AffinePoint<F>) pairs
     auto const points = deserialize_points<N, Fp2<N>>(mod_byte_len, extension2, g1_curve, g2_curve, deserializer);
     if (!deserializer.ended()) {
         input_err("Input contains garbage at the end");  
@@ -189,10 +328,37 @@ std::vector<std::uint8_t> run_pairing_b(u8 mod_byte_len, PrimeField<N> const &fi
 
 
     // Construct BN engine
-    ENGINE const engine(u, u_is_negative, twist_type, g2_curve, e6_non_residue);
+    ENGINE const engine(u, u_is_negative, twist_type, g2_curve, e6_non_residue, line_cache_key);
 
-    // Execute pairing
-    auto const opairing_result = engine.pair(points, extension12);
+    // Execute pairing, together with the checks of the batch that share the parameters
+    std::optional<Fp12<N>> opairing_result;
+    if (batch != nullptr)
+    {
+        auto const batchable = PairingBatchCurves::getInstance().batchable(line_cache_key, [&]() {
+            auto const order = repr_from_limbs<N>(g1_curve.subgroup_order());
+            return ENGINE::parameters_of_u(field.mod(), g1_curve.subgroup_order(), u, u_is_negative) && order && is_probable_prime(order.value(), PAIRING_BATCH_PRIME_ROUNDS);
+        });
+        if (batchable)
+        {
+            auto const miller_value = engine.miller_value(points, extension12);
+            auto f = miller_value;
+            batch_miller_values(engine, line_cache_key, mod_byte_len, extension2, extension12, g1_curve, g2_curve, f, *batch);
+            auto const batch_result = engine.final_exponentiate(f);
+            auto const verified = batch_result && batch_result.value() == Fp12<N>::one(extension12);
+            for (auto &verdict : batch->verdicts)
+            {
+                if (verdict == BATCH_VERIFIED && !verified)
+                {
+                    verdict = BATCH_RUN_ALONE;
+                }
+            }
+            opairing_result = verified ? batch_result : engine.final_exponentiate(miller_value);
+        }
+    }
+    if (!opairing_result)
+    {
+        opairing_result = engine.pair(points, extension12);
+    }
     if (!opairing_result)
     {
         unknown_parameter_err("BN/BLS12 pairing engine returned no value");
@@ -272,7 +438,7 @@ std::vector<std::uint8_t> run_pairing_mnt(u8 mod_byte_len, PrimeField<N> const &
     }
     auto const exp_w0_is_negative = deserialize_sign(deserializer);
 
-    // deser (CurvePoint<Fp<N>>,CurvePoint<F>) pairs
+    // deser (AffinePoint<Fp<N>>,AffinePoint<F>) pairs
     auto const points = deserialize_points<N, F>(mod_byte_len, extension, g1_curve, g2_curve, deserializer);
     if (!deserializer.ended()) {
         input_err("Input contains garbage at the end");  
@@ -311,7 +477,7 @@ std::vector<std::uint8_t> run_pairing_mnt(u8 mod_byte_len, PrimeField<N> const &
 
 // Executes operation with known limb length
 template <usize N>
-std::vector<std::uint8_t> run_operation(u8 operation, std::optional<u8> curve_type, u8 mod_byte_len, Deserializer deserializer)
+std::vector<std::uint8_t> run_operation(u8 operation, std::optional<u8> curve_type, u8 mod_byte_len, Deserializer deserializer, PairingBatch *batch)
 {
     // deser Modulus -> Field
     auto const modulus = deserialize_modulus<N>(mod_byte_len, deserializer);
@@ -330,9 +496,9 @@ std::vector<std::uint8_t> run_operation(u8 operation, std::optional<u8> curve_ty
         case MNT6:
             return run_pairing_mnt<Fp3<N>, Fp6_2<N>, FieldExtension2over3<N>, FieldExtension3<N>, MNT6engine<N>, N, 6>(mod_byte_len, field, 3, deserializer);
         case BLS12:
-            return run_pairing_b<BLS12engine<N>>(mod_byte_len, field, MAX_BLS12_X_BIT_LENGTH, deserializer);
+            return run_pairing_b<BLS12engine<N>>(mod_byte_len, field, MAX_BLS12_X_BIT_LENGTH, deserializer, batch);
         case BN:
-            return run_pairing_b<BNengine<N>>(mod_byte_len, field, MAX_BN_U_BIT_LENGTH, deserializer);
+            return run_pairing_b<BNengine<N>>(mod_byte_len, field, MAX_BN_U_BIT_LENGTH, deserializer, batch);
         default:
             input_err(stringf("invalid curve type %u", curve_type_value));
         }
@@ -347,6 +513,9 @@ std::vector<std::uint8_t> run_operation(u8 operation, std::optional<u8> curve_ty
         case OPERATION_G2_ADD:
         case OPERATION_G2_MUL:
         case OPERATION_G2_MULTIEXP:
+        case OPERATION_G2_REGISTER_BASES:
+        case OPERATION_G2_MULTIEXP_WITH_BASES:
+        case OPERATION_G2_LARGE_MULTIEXP:
             {
                 auto const decoded_ext_degree = deserializer.byte("Input is not long enough to get extension degree");
                 if (!(decoded_ext_degree == 2 || decoded_ext_degree == 3)) {
@@ -387,7 +556,7 @@ std::vector<std::uint8_t> run_operation(u8 operation, std::optional<u8> curve_ty
     }
 }
 
-std::vector<std::uint8_t> run_limbed(u8 operation, std::optional<u8> curve_type, Deserializer deserializer)
+std::vector<std::uint8_t> run_limbed(u8 operation, std::optional<u8> curve_type, Deserializer deserializer, PairingBatch *batch = nullptr)
 {
     // Deserialize modulus length
     auto mod_byte_len = deserializer.byte("Input is not long enough to get modulus length");
@@ -412,37 +581,188 @@ std::vector<std::uint8_t> run_limbed(u8 operation, std::optional<u8> curve_type,
     case 2:
     case 3:
     case 4:
-        return run_operation<4>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<4>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 5:
-        return run_operation<5>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<5>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 6:
-        return run_operation<6>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<6>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 7:
-        return run_operation<7>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<7>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 8:
-        return run_operation<8>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<8>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 9:
-        return run_operation<9>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<9>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 10:
-        return run_operation<10>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<10>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 11:
-        return run_operation<11>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<11>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 12:
-        return run_operation<12>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<12>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 13:
-        return run_operation<13>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<13>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 14:
-        return run_operation<14>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<14>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 15:
-        return run_operation<15>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<15>(operation, curve_type, mod_byte_len, deserializer, batch);
     case 16:
-        return run_operation<16>(operation, curve_type, mod_byte_len, deserializer);
+        return run_operation<16>(operation, curve_type, mod_byte_len, deserializer, batch);
 
     default:
         unimplemented(stringf("operations are not supported for %u modulus limbs", limb_count));
     }
 }
 
+void configure_fixed_base_cache(std::size_t max_bytes, std::uint32_t threshold)
+{
+    auto &cache = FixedBaseCache::getInstance();
+    cache.threshold = threshold;
+    cache.tables.set_capacity(max_bytes);
+    if (max_bytes == 0)
+    {
+        cache.tables.clear();
+        cache.seen.clear();
+    }
+}
+
+void configure_pairing_line_cache(std::size_t max_bytes)
+{
+    auto &cache = LineCache::getInstance();
+    cache.lines.set_capacity(max_bytes);
+    if (max_bytes == 0)
+    {
+        cache.lines.clear();
+    }
+}
+
+void configure_parallel_pairing(bool enabled)
+{
+    PairingSettings::getInstance().parallel = enabled;
+}
+
+void configure_threads(std::size_t threads)
+{
+    ThreadPool::getInstance().set_threads(threads);
+}
+
+void configure_multiexp_endomorphism(bool enabled)
+{
+    EndomorphismSettings::getInstance().enabled = enabled;
+}
+
+std::variant<std::vector<std::uint8_t>, std::basic_string<char>> run_large_multiexp(std::vector<std::uint8_t> const &input)
+{
+    try
+    {
+        auto deserializer = Deserializer(input);
+        auto const operation = deserializer.byte("Input should be longer than operation type encoding");
+        switch (operation)
+        {
+        case OPERATION_G1_MULTIEXP:
+            return run_limbed(OPERATION_G1_LARGE_MULTIEXP, std::nullopt, deserializer);
+        case OPERATION_G2_MULTIEXP:
+            return run_limbed(OPERATION_G2_LARGE_MULTIEXP, std::nullopt, deserializer);
+        default:
+            input_err("Large multiexp is either G1 or G2 multiexp");
+        }
+    }
+    catch (std::domain_error const &e)
+    {
+        return e.what();
+    }
+    catch (std::runtime_error const &e)
+    {
+        return e.what();
+    }
+}
+
+std::variant<std::uint64_t, std::basic_string<char>> register_multiexp_bases(std::vector<std::uint8_t> const &input)
+{
+    try
+    {
+        auto deserializer = Deserializer(input);
+        auto const operation = deserializer.byte("Input should be longer than operation type encoding");
+
+        u8 register_operation;
+        switch (operation)
+        {
+        case OPERATION_G1_MULTIEXP:
+            register_operation = OPERATION_G1_REGISTER_BASES;
+            break;
+        case OPERATION_G2_MULTIEXP:
+            register_operation = OPERATION_G2_REGISTER_BASES;
+            break;
+        default:
+            input_err("Base sets are registered for G1 or G2 multiexp");
+        }
+
+        auto const encoded = run_limbed(register_operation, std::nullopt, deserializer);
+        std::uint64_t handle = 0;
+        for (auto const b : encoded)
+        {
+            handle = (handle << 8) | b;
+        }
+        return handle;
+    }
+    catch (std::domain_error const &e)
+    {
+        return e.what();
+    }
+    catch (std::runtime_error const &e)
+    {
+        return e.what();
+    }
+}
+
+std::variant<std::vector<std::uint8_t>, std::basic_string<char>> multiexp_with_bases(std::uint64_t handle, std::vector<std::uint8_t> const &scalars)
+{
+    try
+    {
+        auto const set = MultiexpBaseSets::getInstance().sets.get(MultiexpBaseSets::key(handle));
+        if (!set)
+        {
+            input_err("Unknown base set handle");
+        }
+
+        // Curve of the set, handle and scalars, decoded by the operation of the set
+        std::vector<std::uint8_t> input(set->curve.cbegin(), set->curve.cend());
+        for (usize i = 8; i-- > 0;)
+        {
+            input.push_back(u8(handle >> (8 * i)));
+        }
+        input.insert(input.end(), scalars.cbegin(), scalars.cend());
+
+        return run_limbed(set->operation, std::nullopt, Deserializer(input));
+    }
+    catch (std::domain_error const &e)
+    {
+        return e.what();
+    }
+    catch (std::runtime_error const &e)
+    {
+        return e.what();
+    }
+}
+
+void release_multiexp_bases(std::uint64_t handle)
+{
+    MultiexpBaseSets::getInstance().sets.erase(MultiexpBaseSets::key(handle));
+}
+
+void configure_multiexp_bases(std::size_t max_bytes)
+{
+    MultiexpBaseSets::getInstance().sets.set_capacity(max_bytes);
+}
+
+MultiexpStats multiexp_stats()
+{
+    return MultiexpCounters::getInstance().stats();
+}
+
+void reset_multiexp_stats()
+{
+    MultiexpCounters::getInstance().reset();
+}
+
 // Main API function which receives ABI input and returns the result of operations, or description of occured error.
 std::variant<std::vector<std::uint8_t>, std::basic_string<char>>
 run(std::vector<std::uint8_t> const &input)
@@ -570,3 +890,68 @@ run_with_operation(operation_type operation, std::vector<std::uint8_t> const &in
         return e.what();
     }
 }
+
+// Runs every input as run does. BN and BLS12 pairing checks with the same parameters share one final exponentiation,
+// inputs that fail it or can not be decoded run alone. Other inputs run alone in order.
+std::vector<std::variant<std::vector<std::uint8_t>, std::basic_string<char>>>
+run_pairing_batch(std::vector<std::vector<std::uint8_t>> const &inputs)
+{
+    std::vector<std::variant<std::vector<std::uint8_t>, std::basic_string<char>>> results(inputs.size());
+    std::vector<usize> pending(inputs.size());
+    for (usize i = 0; i < inputs.size(); i++)
+    {
+        pending[i] = i;
+    }
+
+    while (!pending.empty())
+    {
+        auto const &input = inputs[pending[0]];
+        PairingBatch batch{inputs, std::vector<usize>(pending.cbegin() + 1, pending.cend()), std::vector<u8>(pending.size() - 1, BATCH_OTHER_CURVE)};
+        try
+        {
+            auto deserializer = Deserializer(input);
+            auto const operation = deserializer.byte("Input should be longer than operation type encoding");
+            std::optional<u8> curve_type;
+            if (operation == OPERATION_PAIRING)
+            {
+                curve_type = deserialize_pairing_curve_type(deserializer);
+            }
+            if (curve_type == BN || curve_type == BLS12)
+            {
+                results[pending[0]] = run_limbed(operation, curve_type, deserializer, &batch);
+            }
+            else
+            {
+                results[pending[0]] = run(input);
+            }
+        }
+        catch (std::domain_error const &e)
+        {
+            results[pending[0]] = e.what();
+        }
+        catch (std::runtime_error const &e)
+        {
+            results[pending[0]] = e.what();
+        }
+
+        std::vector<usize> other_curves;
+        for (usize i = 0; i < batch.members.size(); i++)
+        {
+            auto const member = batch.members[i];
+            switch (batch.verdicts[i])
+            {
+            case BATCH_VERIFIED:
+                results[member] = std::vector<std::uint8_t>{pairing_result_true};
+                break;
+            case BATCH_RUN_ALONE:
+                results[member] = run(inputs[member]);
+                break;
+            default:
+                other_curves.push_back(member);
+            }
+        }
+        pending = other_curves;
+    }
+
+    return results;
+}
@@ -6,9 +6,54 @@
 #include <string>
 
 #include "operation.h"
+#include "instrumentation.h"
 
 // Main API function for ABI.
 std::variant<std::vector<std::uint8_t>, std::basic_string<char>> run(std::vector<std::uint8_t> const &input);
 std::variant<std::vector<std::uint8_t>, std::basic_string<char>> run_with_operation(operation_type operation, std::vector<std::uint8_t> const &input);
 
+// Runs every input as run does and gives the results in the same order. BN and BLS12 pairing checks with the same
+// pairing parameters are verified together: their Miller loop values are raised to random 64 bit weights and multiplied
+// before a single final exponentiation, which is 1 for a batch with a false check with probability below 2^-64.
+// Checks of a batch that is not 1 run alone, as do curves whose modulus and group order are not the polynomials of the
+// loop parameter or whose group order is not prime.
+std::vector<std::variant<std::vector<std::uint8_t>, std::basic_string<char>>> run_pairing_batch(std::vector<std::vector<std::uint8_t>> const &inputs);
+
+// Fixed base multiplication cache for G1 and G2 multiplications. A base gets a precomputed table once it was multiplied
+// threshold times, tables are evicted in LRU order when they take more than max_bytes. Zero max_bytes disables the cache.
+void configure_fixed_base_cache(std::size_t max_bytes, std::uint32_t threshold);
+
+// Cache of prepared G2 line coefficients for BN and BLS12 pairings, keyed by the pairing parameters and the point.
+// Coefficients are evicted in LRU order when they take more than max_bytes. Zero max_bytes disables the cache.
+void configure_pairing_line_cache(std::size_t max_bytes);
+
+// G1 or G2 multiexp over any number of pairs. Same input as the multiexp operations except that the number of pairs
+// takes 4 bytes (big endian). Pairs are decoded and computed in chunks, so memory beyond the input does not grow with it.
+std::variant<std::vector<std::uint8_t>, std::basic_string<char>> run_large_multiexp(std::vector<std::uint8_t> const &input);
+
+// Base sets for G1 and G2 multiexps that repeat the same points with new scalars. register_multiexp_bases takes
+// a G1 or G2 multiexp input without the scalars (operation, curve, number of points and the points) and precomputes
+// multiples of the points. multiexp_with_bases takes the scalars of all points in order, encoded as in a multiexp input.
+// Sets are evicted in LRU order when they take more than max_bytes, a released or evicted handle gives an error.
+std::variant<std::uint64_t, std::basic_string<char>> register_multiexp_bases(std::vector<std::uint8_t> const &input);
+std::variant<std::vector<std::uint8_t>, std::basic_string<char>> multiexp_with_bases(std::uint64_t handle, std::vector<std::uint8_t> const &scalars);
+void release_multiexp_bases(std::uint64_t handle);
+void configure_multiexp_bases(std::size_t max_bytes);
+
+// Number of threads, including the calling one, that G1 and G2 multiexp spread Pippenger windows over. Results do not depend on it.
+// Defaults to 1, where everything runs on the calling thread.
+void configure_threads(std::size_t threads);
+
+// Splits the pairs of a pairing over the same threads, every thread runs the Miller loop of its pairs and the parts are
+// multiplied before one final exponentiation. The result is the same as on one thread. Off by default.
+void configure_parallel_pairing(bool enabled);
+
+// Endomorphism split of G1 multiexp scalars for curves with A = 0 and p = 1 mod 3, which roughly halves Pippenger windows.
+// Only correct when all points are in the subgroup of the given order, so it is off by default.
+void configure_multiexp_endomorphism(bool enabled);
+
+// Number of G1 and G2 multiexp calls that went to Straus and Pippenger, and the windows they used.
+MultiexpStats multiexp_stats();
+void reset_multiexp_stats();
+
 #endif
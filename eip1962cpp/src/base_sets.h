@@ -0,0 +1,184 @@
+#ifndef H_BASE_SETS
+#define H_BASE_SETS
+
+#include <atomic>
+
+#include "common.h"
+#include "constants.h"
+#include "curve.h"
+#include "cache.h"
+#include "multiexp.h"
+
+/*
+Base sets for multiexps that are repeated over the same points with new scalars (e.g. verifying keys).
+
+With window width c a set holds 2^(c*k) * P_i for every base P_i and window k, in affine form.
+A multiexp over the set is then a single Pippenger window over all of these multiples, where multiple (i, k) gets
+digit k of scalar i: every window shares the same buckets, there is one bucket sum and no doublings.
+Sets are kept in a bounded LRU cache and addressed by the handle returned on registration.
+*/
+
+// Multiples of one base set, stored as limbs so that they do not depend on the field of the call that built them
+class MultiexpBaseSet
+{
+public:
+    // Operation and curve encoding the set was registered with, a multiexp over the set decodes the curve from them
+    u8 const operation;
+    std::string const curve;
+    usize const points;
+    usize const windows;
+    PippengerPlan const plan;
+    usize const point_limbs;
+    std::vector<u64> const limbs;
+
+    MultiexpBaseSet(u8 operation, std::string curve, usize points, usize windows, PippengerPlan plan, usize point_limbs, std::vector<u64> limbs) : operation(operation), curve(curve), points(points), windows(windows), plan(plan), point_limbs(point_limbs), limbs(limbs) {}
+
+    usize bytes() const
+    {
+        return limbs.size() * sizeof(u64) + curve.size() + sizeof(MultiexpBaseSet);
+    }
+
+    // All multiples, the one of base i and window k is at i * windows + k
+    template <class E, class C>
+    std::vector<AffinePoint<E>> multiples(C const &context) const
+    {
+        constexpr auto element_limbs = ElementLimbs<E>::count;
+        std::vector<AffinePoint<E>> res;
+        res.reserve(points * windows);
+        for (usize i = 0; i < points * windows; i++)
+        {
+            auto const src = limbs.data() + i * point_limbs;
+            res.push_back(AffinePoint(ElementLimbs<E>::load(src, context), ElementLimbs<E>::load(src + element_limbs, context)));
+        }
+        return res;
+    }
+};
+
+// Plan for a set of the given size: the cost of one Pippenger window over points * windows multiples, see pippenger_cost
+template <class E>
+PippengerPlan base_set_plan(usize points, usize scalar_bits, u8 extension_degree, WeierstrassCurve<E> const &wc)
+{
+    auto const limbs = ElementLimbs<E>::count / extension_degree;
+    auto const costs = pippenger_point_costs(limbs, extension_degree, wc.ctype() == CurveType::AIsZero);
+
+    PippengerPlan best{1, false};
+    double best_cost = 0;
+    for (usize c = 1; c <= MULTIEXP_MAX_WINDOW; c++)
+    {
+        for (bool batch_affine : {false, true})
+        {
+            PippengerPlan const plan{c, batch_affine};
+            auto const cost = pippenger_cost(points * (scalar_bits / c + 1), 0, plan, costs);
+            if (c == 1 || cost < best_cost)
+            {
+                best = plan;
+                best_cost = cost;
+            }
+        }
+    }
+    return best;
+}
+
+// scalar_bits: longest scalar the set is used with
+template <class E, class C>
+std::shared_ptr<MultiexpBaseSet const> build_base_set(u8 operation, std::string const &curve, std::vector<AffinePoint<E>> const &bases, usize scalar_bits, u8 extension_degree, WeierstrassCurve<E> const &wc, C const &context)
+{
+    auto const plan = base_set_plan(bases.size(), scalar_bits, extension_degree, wc);
+    // The top digit may carry into one more window
+    auto const windows = scalar_bits / plan.window + 1;
+
+    std::vector<CurvePoint<E>> multiples;
+    multiples.reserve(bases.size() * windows);
+    for (auto const &base : bases)
+    {
+        auto multiple = CurvePoint<E>(base);
+        for (usize k = 0; k < windows; k++)
+        {
+            multiples.push_back(multiple);
+            for (usize i = 0; i < plan.window; i++)
+            {
+                multiple.mul2(wc);
+            }
+        }
+    }
+
+    auto const affine = batch_into_affine(multiples);
+
+    constexpr auto element_limbs = ElementLimbs<E>::count;
+    std::vector<u64> limbs(affine.size() * 2 * element_limbs);
+    for (usize i = 0; i < affine.size(); i++)
+    {
+        ElementLimbs<E>::store(affine[i].x, limbs.data() + 2 * i * element_limbs);
+        ElementLimbs<E>::store(affine[i].y, limbs.data() + (2 * i + 1) * element_limbs);
+    }
+
+    return std::make_shared<MultiexpBaseSet const>(operation, curve, bases.size(), windows, plan, 2 * element_limbs, limbs);
+}
+
+// Multiexp of the bases of the set with the scalars, one per base
+template <class E, class C>
+CurvePoint<E> base_set_multiexp(MultiexpBaseSet const &set, std::vector<std::vector<u64>> const &scalars, WeierstrassCurve<E> const &wc, C const &context)
+{
+    assert(scalars.size() == set.points);
+    auto const c = set.plan.window;
+    auto const multiples = set.multiples<E>(context);
+    std::vector<AffinePoint<E>> negated(multiples);
+    for (auto &p : negated)
+    {
+        p.negate();
+    }
+    auto const points = [&](usize i) -> AffinePoint<E> const & { return multiples[i]; };
+
+    // A single window, digit k of scalar i goes with multiple (i, k). One spare digit for a scalar that is too long.
+    PippengerDigits digits{multiples.size(), 1, std::vector<i32>(multiples.size() + 1, 0)};
+    for (usize i = 0; i < scalars.size(); i++)
+    {
+        if (into_signed_digits(scalars[i], c, digits.digits.data() + i * set.windows, 1) > set.windows)
+        {
+            input_err("Scalar is too long for the base set");
+        }
+    }
+
+    auto const tasks = pippenger_tasks(1, multiples.size(), ThreadPool::getInstance().threads());
+    return combine_pippenger_tasks<CurvePoint<E>>(tasks, 1, c, wc, context, [&](PippengerTask const &task) {
+        if (set.plan.batch_affine)
+        {
+            return batch_affine_window_sums(points, negated, digits, task, c, wc, context);
+        }
+        return bucket_window_sums<CurvePoint>(points, negated, digits, task, c, wc, context);
+    });
+}
+
+// Process wide registry of base sets, keyed by handle
+class MultiexpBaseSets
+{
+public:
+    static MultiexpBaseSets &getInstance()
+    {
+        static MultiexpBaseSets instance;
+        return instance;
+    }
+
+    LruCache<MultiexpBaseSet> sets;
+    std::atomic<u64> next_handle;
+
+    static std::string key(u64 handle)
+    {
+        return std::to_string(handle);
+    }
+
+    u64 add(std::shared_ptr<MultiexpBaseSet const> set)
+    {
+        auto const handle = next_handle++;
+        sets.put(key(handle), set, set->bytes());
+        return handle;
+    }
+
+private:
+    MultiexpBaseSets() : sets(MULTIEXP_BASE_SETS_MAX_BYTES), next_handle(1) {}
+    ~MultiexpBaseSets() = default;
+    MultiexpBaseSets(const MultiexpBaseSets &) = delete;
+    MultiexpBaseSets &operator=(const MultiexpBaseSets &) = delete;
+};
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef H_CACHE
+#define H_CACHE
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "common.h"
+#include "fp.h"
+#include "extension_towers/fp2.h"
+#include "extension_towers/fp3.h"
+
+/*
+Caches that outlive a single call. Elements keep a reference to their field, and fields only live for the duration
+of one call, so cached elements are stored as raw Montgomery limbs and loaded back with the field of the call that uses them.
+Keys are byte strings of the encoded parameters, so equal limbs always mean equal fields.
+*/
+
+// ********************** ELEMENT LIMBS ********************** //
+
+// E: Element
+template <class E>
+struct ElementLimbs;
+
+template <usize N>
+struct ElementLimbs<Fp<N>>
+{
+    static constexpr usize count = N;
+
+    static void store(Fp<N> const &element, u64 *dst)
+    {
+        auto const repr = element.representation();
+        std::copy(repr.cbegin(), repr.cend(), dst);
+    }
+
+    template <class C>
+    static Fp<N> load(u64 const *src, C const &context)
+    {
+        PrimeField<N> const &field = context;
+        Repr<N> repr;
+        std::copy(src, src + N, repr.begin());
+        return Fp<N>(repr, field);
+    }
+};
+
+template <usize N>
+struct ElementLimbs<Fp2<N>>
+{
+    static constexpr usize count = 2 * N;
+
+    static void store(Fp2<N> const &element, u64 *dst)
+    {
+        ElementLimbs<Fp<N>>::store(element.c0, dst);
+        ElementLimbs<Fp<N>>::store(element.c1, dst + N);
+    }
+
+    template <class C>
+    static Fp2<N> load(u64 const *src, C const &context)
+    {
+        FieldExtension2<N> const &field = context;
+        return Fp2<N>(ElementLimbs<Fp<N>>::load(src, field), ElementLimbs<Fp<N>>::load(src + N, field), field);
+    }
+};
+
+template <usize N>
+struct ElementLimbs<Fp3<N>>
+{
+    static constexpr usize count = 3 * N;
+
+    static void store(Fp3<N> const &element, u64 *dst)
+    {
+        ElementLimbs<Fp<N>>::store(element.c0, dst);
+        ElementLimbs<Fp<N>>::store(element.c1, dst + N);
+        ElementLimbs<Fp<N>>::store(element.c2, dst + 2 * N);
+    }
+
+    template <class C>
+    static Fp3<N> load(u64 const *src, C const &context)
+    {
+        FieldExtension3<N> const &field = context;
+        return Fp3<N>(ElementLimbs<Fp<N>>::load(src, field), ElementLimbs<Fp<N>>::load(src + N, field), ElementLimbs<Fp<N>>::load(src + 2 * N, field), field);
+    }
+};
+
+// ********************** LRU CACHE ********************** //
+
+struct CacheStats
+{
+    u64 hits;
+    u64 misses;
+    u64 evictions;
+    usize entries;
+    usize bytes;
+};
+
+// V: Value
+// Thread-safe map from byte strings to immutable values, bounded by the total size of the values.
+// Least recently used entries are evicted first. A capacity of zero disables the cache.
+template <class V>
+class LruCache
+{
+    typedef std::tuple<std::string, std::shared_ptr<V const>, usize> Entry;
+
+    mutable std::mutex mutex;
+    usize capacity_bytes;
+    usize used_bytes = 0;
+    // Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, typename std::list<Entry>::iterator> index;
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 evictions = 0;
+
+public:
+    LruCache(usize capacity_bytes) : capacity_bytes(capacity_bytes) {}
+
+    LruCache(LruCache const &) = delete;
+    LruCache &operator=(LruCache const &) = delete;
+
+    std::shared_ptr<V const> get(std::string const &key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto const it = index.find(key);
+        if (it == index.end())
+        {
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        entries.splice(entries.begin(), entries, it->second);
+        return std::get<1>(*it->second);
+    }
+
+    // Inserts or replaces the value, values larger than the whole capacity are not stored
+    void put(std::string const &key, std::shared_ptr<V const> value, usize bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto const it = index.find(key);
+        if (it != index.end())
+        {
+            used_bytes -= std::get<2>(*it->second);
+            entries.erase(it->second);
+            index.erase(it);
+        }
+        if (bytes > capacity_bytes)
+        {
+            return;
+        }
+        entries.push_front(Entry(key, value, bytes));
+        index[key] = entries.begin();
+        used_bytes += bytes;
+        evict();
+    }
+
+    void erase(std::string const &key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto const it = index.find(key);
+        if (it != index.end())
+        {
+            used_bytes -= std::get<2>(*it->second);
+            entries.erase(it->second);
+            index.erase(it);
+        }
+    }
+
+    void set_capacity(usize bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        capacity_bytes = bytes;
+        evict();
+    }
+
+    usize capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return capacity_bytes;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        index.clear();
+        used_bytes = 0;
+    }
+
+    CacheStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return CacheStats{hits, misses, evictions, entries.size(), used_bytes};
+    }
+
+private:
+    void evict()
+    {
+        while (used_bytes > capacity_bytes)
+        {
+            auto const &last = entries.back();
+            used_bytes -= std::get<2>(last);
+            index.erase(std::get<0>(last));
+            entries.pop_back();
+            evictions++;
+        }
+    }
+};
+
+#endif
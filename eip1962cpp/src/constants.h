@@ -36,6 +36,15 @@ static const u8 OPERATION_G2_MULTIEXP = 0x06;
 
 static const u8 OPERATION_PAIRING = 0x07;
 
+// ************************** Internal operations ***************************** //
+// Not part of the ABI, entry points in api.h run through these to reuse the curve decoding of G1 and G2 multiexp
+static const u8 OPERATION_G1_REGISTER_BASES = 0x83;
+static const u8 OPERATION_G2_REGISTER_BASES = 0x86;
+static const u8 OPERATION_G1_MULTIEXP_WITH_BASES = 0x93;
+static const u8 OPERATION_G2_MULTIEXP_WITH_BASES = 0x96;
+static const u8 OPERATION_G1_LARGE_MULTIEXP = 0xa3;
+static const u8 OPERATION_G2_LARGE_MULTIEXP = 0xa6;
+
 // Usefull constants //
 
 static const usize NUM_LIMBS_MIN = 4;
@@ -64,4 +73,30 @@ static const usize MNT6_MAX_MODULUS_POWER = 6;
 static const usize BN_MAX_MODULUS_POWER = 6;
 static const usize BLS12_MAX_MODULUS_POWER = 6;
 
+// ****************************** Caches **************************** //
+// Number of multiplications of the same base before a fixed base table is built for it
+static const u32 FIXED_BASE_CACHE_THRESHOLD = 4;
+static const usize FIXED_BASE_WINDOW = 4;
+static const usize FIXED_BASE_CACHE_MAX_BYTES = 64 * 1024 * 1024;
+static const usize FIXED_BASE_SEEN_MAX_BYTES = 1024 * 1024;
+static const usize MULTIEXP_BASE_SETS_MAX_BYTES = 256 * 1024 * 1024;
+static const usize ENDOMORPHISM_CACHE_MAX_BYTES = 64 * 1024;
+static const usize LINE_CACHE_MAX_BYTES = 16 * 1024 * 1024;
+static const usize PAIRING_BATCH_CURVES_MAX_BYTES = 64 * 1024;
+
+// ****************************** Multiexp **************************** //
+// Fewest points per chunk when a parallel Pippenger splits points as well as windows
+static const usize MULTIEXP_PARALLEL_MIN_CHUNK = 64;
+// Pairs decoded at once by a large multiexp
+static const usize MULTIEXP_STREAM_CHUNK = 1024;
+// Fewest pairs for the endomorphism split. Below it the split measures slower than the cost model expects,
+// see `make bench FILTER=multiexp_endomorphism`
+static const usize MULTIEXP_ENDOMORPHISM_MIN_PAIRS = 512;
+
+// ****************************** Pairings **************************** //
+// Fewest pairs per thread of a parallel Miller loop, every thread repeats the squarings of the accumulator
+static const usize PAIRING_PARALLEL_MIN_PAIRS = 2;
+// Miller-Rabin rounds on the group order before checks of a curve are batched
+static const usize PAIRING_BATCH_PRIME_ROUNDS = 20;
+
 #endif
\ No newline at end of file
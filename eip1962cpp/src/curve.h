@@ -19,12 +19,16 @@ class WeierstrassCurve
     CurveType cty;
     E a;
     E b;
+    E b3;
     std::vector<u64> subgroup_order_;
     u8 order_len_;
 
 public:
-    WeierstrassCurve(E a, E b, std::vector<u64> subgroup_order, u8 order_len) : a(a), b(b), subgroup_order_(subgroup_order), order_len_(order_len)
+    WeierstrassCurve(E a, E b, std::vector<u64> subgroup_order, u8 order_len) : a(a), b(b), b3(b), subgroup_order_(subgroup_order), order_len_(order_len)
     {
+        b3.mul2();
+        b3.add(b);
+
         cty = CurveType::Generic;
         if (a.is_zero())
         {
@@ -42,6 +46,12 @@ public:
         return b;
     }
 
+    // 3 * B, used by the complete projective formulas
+    E const &get_b3() const
+    {
+        return b3;
+    }
+
     u8 order_len() const
     {
         return order_len_;
@@ -63,54 +73,45 @@ public:
     }
 };
 
-// ****************************** CURVE POINT ***************************** //
+// ****************************** AFFINE POINT ***************************** //
+template <class E>
+class CurvePoint;
+
 // E: Element
+// Point in affine coordinates. Point at infinity is encoded as (0, 0) same as in the ABI,
+// which is never on the curve as curves with B = 0 are rejected.
 template <class E>
-class CurvePoint
+class AffinePoint
 {
 
 public:
     E x;
     E y;
-    E z;
-
-    CurvePoint(E x, E y, E z) : x(x), y(y), z(z) {}
 
-    CurvePoint(E x, E y) : CurvePoint(x, y, x.one())
-    {
-        if (x.is_zero() && y.is_zero()) {
-            this->x = x.zero();
-            this->y = y.one();
-            this->z = z.zero();
-        }
-    }
+    AffinePoint(E x, E y) : x(x), y(y) {}
 
     template <class C>
-    static CurvePoint<E> zero(C const &context)
+    static AffinePoint<E> zero(C const &context)
     {
-        return CurvePoint(E::zero(context), E::one(context), E::zero(context));
+        return AffinePoint(E::zero(context), E::zero(context));
     }
 
-    auto operator=(CurvePoint<E> const &other)
+    auto operator=(AffinePoint<E> const &other)
     {
         x = other.x;
         y = other.y;
-        z = other.z;
     }
 
-    std::tuple<E, E> xy() const
+    bool is_zero() const
     {
-        if (is_zero())
-        {
-            return tuple(x.zero(), x.zero());
-        }
+        return x.is_zero() && y.is_zero();
+    }
 
-        auto point = *this;
-        if (point.is_normalized()) {
-            return tuple(point.x, point.y);
-        } else {
-            point.normalize();
-            return point.xy();
+    void negate()
+    {
+        if (!is_zero())
+        {
+            y.negate();
         }
     }
 
@@ -139,35 +140,105 @@ public:
     template <class C>
     bool check_correct_subgroup(WeierstrassCurve<E> const &wc, C const &context) const
     {
-        // auto const p = mul(wc.subgroup_order(), wc, context);
-
-        auto const p = wnaf_mul(wc.subgroup_order(), wc, context);
+        auto const p = CurvePoint<E>(*this).wnaf_mul(wc.subgroup_order(), wc, context);
 
         return p.is_zero();
     }
 
     void serialize(u8 mod_byte_len, std::vector<u8> &data) const
     {
-        auto const pair = xy();
-        std::get<0>(pair).serialize(mod_byte_len, data);
-        std::get<1>(pair).serialize(mod_byte_len, data);
+        x.serialize(mod_byte_len, data);
+        y.serialize(mod_byte_len, data);
     }
 
-    bool is_zero() const
+    // Returnes multiple of this by a scalar using mixed additions
+    template <class C>
+    CurvePoint<E> mul(std::vector<u64> const &scalar, WeierstrassCurve<E> const &wc, C const &context) const
     {
-        return z.is_zero();
+        auto res = CurvePoint<E>::zero(context);
+        auto found_one = false;
+        for (auto it = RevBitIterator(scalar); it.before();)
+        {
+            auto i = *it;
+            if (found_one)
+            {
+                res.mul2(wc);
+            }
+            else
+            {
+                found_one = i;
+            }
+
+            if (i)
+            {
+                res.add_mixed(*this, wc, context);
+            }
+        }
+
+        return res;
+    }
+};
+
+// ****************************** CURVE POINT ***************************** //
+// E: Element
+// Point in Jacobian coordinates.
+template <class E>
+class CurvePoint
+{
+
+public:
+    E x;
+    E y;
+    E z;
+
+    CurvePoint(E x, E y, E z) : x(x), y(y), z(z) {}
+
+    explicit CurvePoint(AffinePoint<E> const &p) : CurvePoint(p.x, p.y, p.x.one())
+    {
+        if (p.is_zero()) {
+            this->y = y.one();
+            this->z = z.zero();
+        }
+    }
+
+    template <class C>
+    static CurvePoint<E> zero(C const &context)
+    {
+        return CurvePoint(E::zero(context), E::one(context), E::zero(context));
     }
 
-    bool is_normalized() const
+    auto operator=(CurvePoint<E> const &other)
+    {
+        x = other.x;
+        y = other.y;
+        z = other.z;
+    }
+
+    AffinePoint<E> into_affine() const
     {
         if (is_zero())
         {
-            return true;
+            return AffinePoint(x.zero(), x.zero());
         }
 
-        auto const one = z.one();
+        auto point = *this;
+        point.normalize();
+        if (point.is_zero())
+        {
+            return AffinePoint(x.zero(), x.zero());
+        }
 
-        return z == one;
+        return AffinePoint(point.x, point.y);
+    }
+
+    void serialize(u8 mod_byte_len, std::vector<u8> &data) const
+    {
+        into_affine().serialize(mod_byte_len, data);
+    }
+
+    bool is_zero() const
+    {
+        return z.is_zero();
     }
 
     void negate()
@@ -195,46 +266,10 @@ public:
         }
     }
 
-    // Returnes multiple of this by a scalar using mixed additions
-    template <class C>
-    CurvePoint<E> mul_mixed_addition(std::vector<u64> const &scalar, WeierstrassCurve<E> const &wc, C const &context) const
-    {
-        assert(z == x.one());
-
-        auto res = CurvePoint<E>::zero(context);
-        auto const base = *this;
-        auto found_one = false;
-        for (auto it = RevBitIterator(scalar); it.before();)
-        {
-            auto i = *it;
-            if (found_one)
-            {
-                res.mul2(wc);
-            }
-            else
-            {
-                found_one = i;
-            }
-
-            if (i)
-            {
-                res.add_mixed(base, wc, context);
-            }
-        }
-
-        return res;
-    }
-
     // Returnes multiple of this by a scalar.
     template <class C>
     CurvePoint<E> mul(std::vector<u64> const &scalar, WeierstrassCurve<E> const &wc, C const &context) const
     {
-        // Not using this is less performant, but for now it is simplier.
-        if (z == x.one())
-        {
-            return mul_mixed_addition(scalar, wc, context);
-        }
-
         auto res = CurvePoint<E>::zero(context);
         auto const base = *this;
         auto found_one = false;
@@ -330,12 +365,6 @@ public:
             return;
         }
 
-        if (b.z == E::one(context))
-        {
-            this->add_mixed(b, wc, context);
-            return;
-        }
-
         // http://www.hyperelliptic.org/EFD/g1p/auto-shortw-jacobian-0.html#addition-add-2007-bl
 
         // Z1Z1 = Z1^2
@@ -425,7 +454,7 @@ public:
     }
 
     template <class C>
-    void add_mixed(CurvePoint<E> const &b, WeierstrassCurve<E> const &wc, C const &context)
+    void add_mixed(AffinePoint<E> const &b, WeierstrassCurve<E> const &wc, C const &context)
     {
         if (b.is_zero())
         {
@@ -434,13 +463,7 @@ public:
 
         if (this->is_zero())
         {
-            *this = b;
-            return;
-        }
-
-        if (b.z != E::one(context))
-        {
-            this->add(b, wc, context);
+            *this = CurvePoint<E>(b);
             return;
         }
 
@@ -683,4 +706,728 @@ private:
     }
 };
 
+// Converts Jacobian points to affine using a single inversion (Montgomery's trick).
+template <class E>
+std::vector<AffinePoint<E>> batch_into_affine(std::vector<CurvePoint<E>> const &points)
+{
+    std::vector<AffinePoint<E>> result;
+    if (points.empty())
+    {
+        return result;
+    }
+
+    auto const zero = points[0].x.zero();
+    result.resize(points.size(), AffinePoint(zero, zero));
+
+    // products of z coordinates of all non-zero points before i
+    std::vector<E> prefix;
+    prefix.reserve(points.size());
+    auto acc = points[0].x.one();
+    for (auto const &p : points)
+    {
+        prefix.push_back(acc);
+        if (!p.is_zero())
+        {
+            acc.mul(p.z);
+        }
+    }
+
+    auto const oacc_inv = acc.inverse();
+    if (!oacc_inv)
+    {
+        for (usize i = 0; i < points.size(); i++)
+        {
+            result[i] = points[i].into_affine();
+        }
+        return result;
+    }
+
+    auto acc_inv = oacc_inv.value();
+    for (usize i = points.size(); i-- > 0;)
+    {
+        auto const &p = points[i];
+        if (p.is_zero())
+        {
+            continue;
+        }
+
+        auto z_inv = acc_inv;
+        z_inv.mul(prefix[i]);
+        acc_inv.mul(p.z);
+
+        auto zinv_powered = z_inv;
+        zinv_powered.square();
+
+        // X/Z^2
+        auto x = p.x;
+        x.mul(zinv_powered);
+
+        // Y/Z^3
+        zinv_powered.mul(z_inv);
+        auto y = p.y;
+        y.mul(zinv_powered);
+
+        result[i] = AffinePoint(x, y);
+    }
+
+    return result;
+}
+
+// E: Element
+// Affine additions into distinct targets that share one inversion (Montgomery's trick).
+// Additions that need no inversion (into an empty target, P + (-P)) are done right away by add,
+// the others are done by run. A target must not get a second addition before run.
+template <class E>
+class BatchAffineAdder
+{
+    std::vector<AffinePoint<E> *> targets;
+    std::vector<AffinePoint<E> const *> sources;
+    // Slope numerators and denominators of the pending additions
+    std::vector<E> numerators;
+    std::vector<E> denominators;
+    std::vector<E> prefix;
+
+public:
+    usize pending() const
+    {
+        return targets.size();
+    }
+
+    // Returns true if the addition is pending until run
+    bool add(AffinePoint<E> &target, AffinePoint<E> const &source, WeierstrassCurve<E> const &wc)
+    {
+        if (source.is_zero())
+        {
+            return false;
+        }
+        if (target.is_zero())
+        {
+            target = source;
+            return false;
+        }
+
+        if (target.x == source.x)
+        {
+            if (!(target.y == source.y) || target.y.is_zero())
+            {
+                target.x = target.x.zero();
+                target.y = target.y.zero();
+                return false;
+            }
+
+            // Doubling, (3x^2 + a) / 2y
+            auto numerator = target.x;
+            numerator.square();
+            auto x2 = numerator;
+            numerator.mul2();
+            numerator.add(x2);
+            numerator.add(wc.get_a());
+            auto denominator = target.y;
+            denominator.mul2();
+            push(target, source, numerator, denominator);
+            return true;
+        }
+
+        // (y2 - y1) / (x2 - x1)
+        auto numerator = source.y;
+        numerator.sub(target.y);
+        auto denominator = source.x;
+        denominator.sub(target.x);
+        push(target, source, numerator, denominator);
+        return true;
+    }
+
+    void run()
+    {
+        if (targets.empty())
+        {
+            return;
+        }
+
+        prefix.clear();
+        auto acc = denominators[0].one();
+        for (auto const &d : denominators)
+        {
+            prefix.push_back(acc);
+            acc.mul(d);
+        }
+
+        // Denominators are never zero, so the product is invertible
+        auto acc_inv = acc.inverse().value();
+        for (usize i = targets.size(); i-- > 0;)
+        {
+            auto lambda = acc_inv;
+            lambda.mul(prefix[i]);
+            acc_inv.mul(denominators[i]);
+            lambda.mul(numerators[i]);
+
+            auto &target = *targets[i];
+            auto const &source = *sources[i];
+
+            // x3 = lambda^2 - x1 - x2
+            auto x3 = lambda;
+            x3.square();
+            x3.sub(target.x);
+            x3.sub(source.x);
+
+            // y3 = lambda * (x1 - x3) - y1
+            auto y3 = target.x;
+            y3.sub(x3);
+            y3.mul(lambda);
+            y3.sub(target.y);
+
+            target.x = x3;
+            target.y = y3;
+        }
+
+        targets.clear();
+        sources.clear();
+        numerators.clear();
+        denominators.clear();
+    }
+
+private:
+    void push(AffinePoint<E> &target, AffinePoint<E> const &source, E const &numerator, E const &denominator)
+    {
+        targets.push_back(&target);
+        sources.push_back(&source);
+        numerators.push_back(numerator);
+        denominators.push_back(denominator);
+    }
+};
+
+// ****************************** PROJECTIVE POINT ***************************** //
+// E: Element
+// Point in homogeneous projective coordinates (X : Y : Z) with x = X/Z, y = Y/Z.
+// Uses the complete formulas of Renes, Costello and Batina (https://eprint.iacr.org/2015/1060),
+// so add and mul2 have no branches on the values of the operands: doubling, adding inverse
+// and adding infinity all go through the same sequence of field operations. Formulas are complete
+// for curves without points of order 2 over the base field, on other curves exceptional pairs
+// of points give (0 : 0 : 0). Jacobian formulas are cheaper, this type is for the places where
+// uniform control flow matters more than operation count.
+template <class E>
+class ProjectivePoint
+{
+
+public:
+    E x;
+    E y;
+    E z;
+
+    ProjectivePoint(E x, E y, E z) : x(x), y(y), z(z) {}
+
+    explicit ProjectivePoint(AffinePoint<E> const &p) : ProjectivePoint(p.x, p.y, p.x.one())
+    {
+        if (p.is_zero()) {
+            this->y = y.one();
+            this->z = z.zero();
+        }
+    }
+
+    template <class C>
+    static ProjectivePoint<E> zero(C const &context)
+    {
+        return ProjectivePoint(E::zero(context), E::one(context), E::zero(context));
+    }
+
+    auto operator=(ProjectivePoint<E> const &other)
+    {
+        x = other.x;
+        y = other.y;
+        z = other.z;
+    }
+
+    AffinePoint<E> into_affine() const
+    {
+        auto const oz_inv = z.inverse();
+        if (!oz_inv)
+        {
+            return AffinePoint(x.zero(), x.zero());
+        }
+
+        auto const z_inv = oz_inv.value();
+        auto ax = x;
+        ax.mul(z_inv);
+        auto ay = y;
+        ay.mul(z_inv);
+
+        return AffinePoint(ax, ay);
+    }
+
+    void serialize(u8 mod_byte_len, std::vector<u8> &data) const
+    {
+        into_affine().serialize(mod_byte_len, data);
+    }
+
+    bool is_zero() const
+    {
+        return z.is_zero();
+    }
+
+    void negate()
+    {
+        y.negate();
+    }
+
+    void mul2(WeierstrassCurve<E> const &wc)
+    {
+        switch (wc.ctype())
+        {
+        case CurveType::Generic:
+            this->mul2_generic(wc);
+            break;
+
+        case CurveType::AIsZero:
+            this->mul2_a_is_zero(wc);
+            break;
+
+        default:
+            unimplemented("only curve with A != 0 and B != 0 or just B != 0 are supported");
+        }
+    }
+
+    template <class C>
+    void add(ProjectivePoint<E> const &b, WeierstrassCurve<E> const &wc, C const &context)
+    {
+        UNUSED(context);
+        switch (wc.ctype())
+        {
+        case CurveType::Generic:
+            this->add_generic(b, wc);
+            break;
+
+        case CurveType::AIsZero:
+            this->add_a_is_zero(b, wc);
+            break;
+
+        default:
+            unimplemented("only curve with A != 0 and B != 0 or just B != 0 are supported");
+        }
+    }
+
+    // Mixed formulas assume Z2 = 1, so infinity encoded as (0, 0) is filtered here.
+    // This branches on the input only, never on the accumulator.
+    template <class C>
+    void add_mixed(AffinePoint<E> const &b, WeierstrassCurve<E> const &wc, C const &context)
+    {
+        UNUSED(context);
+        if (b.is_zero())
+        {
+            return;
+        }
+
+        switch (wc.ctype())
+        {
+        case CurveType::Generic:
+            this->add_mixed_generic(b, wc);
+            break;
+
+        case CurveType::AIsZero:
+            this->add_mixed_a_is_zero(b, wc);
+            break;
+
+        default:
+            unimplemented("only curve with A != 0 and B != 0 or just B != 0 are supported");
+        }
+    }
+
+private:
+    // Algorithm 1 of RCB15: 12M + 3 mul by a + 2 mul by 3b
+    void add_generic(ProjectivePoint<E> const &b, WeierstrassCurve<E> const &wc)
+    {
+        auto const &a = wc.get_a();
+        auto const &b3 = wc.get_b3();
+
+        auto t0 = x;
+        t0.mul(b.x);
+        auto t1 = y;
+        t1.mul(b.y);
+        auto t2 = z;
+        t2.mul(b.z);
+
+        auto t3 = x;
+        t3.add(y);
+        auto t4 = b.x;
+        t4.add(b.y);
+        t3.mul(t4);
+
+        t4 = t0;
+        t4.add(t1);
+        t3.sub(t4);
+        t4 = x;
+        t4.add(z);
+
+        auto t5 = b.x;
+        t5.add(b.z);
+        t4.mul(t5);
+        t5 = t0;
+        t5.add(t2);
+
+        t4.sub(t5);
+        t5 = y;
+        t5.add(z);
+        auto x3 = b.y;
+        x3.add(b.z);
+
+        t5.mul(x3);
+        x3 = t1;
+        x3.add(t2);
+        t5.sub(x3);
+
+        auto z3 = t4;
+        z3.mul(a);
+        x3 = t2;
+        x3.mul(b3);
+        z3.add(x3);
+
+        x3 = t1;
+        x3.sub(z3);
+        z3.add(t1);
+        auto y3 = x3;
+        y3.mul(z3);
+
+        t1 = t0;
+        t1.mul2();
+        t1.add(t0);
+        t2.mul(a);
+
+        t4.mul(b3);
+        t1.add(t2);
+        t2.negate();
+        t2.add(t0);
+
+        t2.mul(a);
+        t4.add(t2);
+        t0 = t1;
+        t0.mul(t4);
+
+        y3.add(t0);
+        t0 = t5;
+        t0.mul(t4);
+        x3.mul(t3);
+
+        x3.sub(t0);
+        t0 = t3;
+        t0.mul(t1);
+        z3.mul(t5);
+
+        z3.add(t0);
+
+        x = x3;
+        y = y3;
+        z = z3;
+    }
+
+    // Algorithm 2 of RCB15: 11M + 3 mul by a + 2 mul by 3b
+    void add_mixed_generic(AffinePoint<E> const &b, WeierstrassCurve<E> const &wc)
+    {
+        auto const &a = wc.get_a();
+        auto const &b3 = wc.get_b3();
+
+        auto t0 = x;
+        t0.mul(b.x);
+        auto t1 = y;
+        t1.mul(b.y);
+        auto t3 = b.x;
+        t3.add(b.y);
+
+        auto t4 = x;
+        t4.add(y);
+        t3.mul(t4);
+        t4 = t0;
+        t4.add(t1);
+
+        t3.sub(t4);
+        t4 = b.x;
+        t4.mul(z);
+        t4.add(x);
+
+        auto t5 = b.y;
+        t5.mul(z);
+        t5.add(y);
+        auto z3 = t4;
+        z3.mul(a);
+
+        auto x3 = z;
+        x3.mul(b3);
+        z3.add(x3);
+        x3 = t1;
+        x3.sub(z3);
+
+        z3.add(t1);
+        auto y3 = x3;
+        y3.mul(z3);
+        t1 = t0;
+        t1.mul2();
+
+        t1.add(t0);
+        auto t2 = z;
+        t2.mul(a);
+        t4.mul(b3);
+
+        t1.add(t2);
+        t2.negate();
+        t2.add(t0);
+        t2.mul(a);
+
+        t4.add(t2);
+        t0 = t1;
+        t0.mul(t4);
+        y3.add(t0);
+
+        t0 = t5;
+        t0.mul(t4);
+        x3.mul(t3);
+        x3.sub(t0);
+
+        t0 = t3;
+        t0.mul(t1);
+        z3.mul(t5);
+        z3.add(t0);
+
+        x = x3;
+        y = y3;
+        z = z3;
+    }
+
+    // Algorithm 3 of RCB15: 8M + 3S + 3 mul by a + 2 mul by 3b
+    void mul2_generic(WeierstrassCurve<E> const &wc)
+    {
+        auto const &a = wc.get_a();
+        auto const &b3 = wc.get_b3();
+
+        auto t0 = x;
+        t0.square();
+        auto t1 = y;
+        t1.square();
+        auto t2 = z;
+        t2.square();
+
+        auto t3 = x;
+        t3.mul(y);
+        t3.mul2();
+        auto z3 = x;
+        z3.mul(z);
+
+        z3.mul2();
+        auto x3 = z3;
+        x3.mul(a);
+        auto y3 = t2;
+        y3.mul(b3);
+
+        y3.add(x3);
+        x3 = t1;
+        x3.sub(y3);
+        y3.add(t1);
+
+        y3.mul(x3);
+        x3.mul(t3);
+        z3.mul(b3);
+
+        t2.mul(a);
+        t3 = t0;
+        t3.sub(t2);
+        t3.mul(a);
+
+        t3.add(z3);
+        z3 = t0;
+        z3.mul2();
+        t0.add(z3);
+
+        t0.add(t2);
+        t0.mul(t3);
+        y3.add(t0);
+
+        t2 = y;
+        t2.mul(z);
+        t2.mul2();
+        t0 = t2;
+        t0.mul(t3);
+
+        x3.sub(t0);
+        z3 = t2;
+        z3.mul(t1);
+        z3.mul2();
+
+        z3.mul2();
+
+        x = x3;
+        y = y3;
+        z = z3;
+    }
+
+    // Algorithm 7 of RCB15: 12M + 2 mul by 3b
+    void add_a_is_zero(ProjectivePoint<E> const &b, WeierstrassCurve<E> const &wc)
+    {
+        auto const &b3 = wc.get_b3();
+
+        auto t0 = x;
+        t0.mul(b.x);
+        auto t1 = y;
+        t1.mul(b.y);
+        auto t2 = z;
+        t2.mul(b.z);
+
+        auto t3 = x;
+        t3.add(y);
+        auto t4 = b.x;
+        t4.add(b.y);
+        t3.mul(t4);
+
+        t4 = t0;
+        t4.add(t1);
+        t3.sub(t4);
+        t4 = y;
+        t4.add(z);
+
+        auto x3 = b.y;
+        x3.add(b.z);
+        t4.mul(x3);
+        x3 = t1;
+        x3.add(t2);
+
+        t4.sub(x3);
+        x3 = x;
+        x3.add(z);
+        auto y3 = b.x;
+        y3.add(b.z);
+
+        x3.mul(y3);
+        y3 = t0;
+        y3.add(t2);
+        y3.negate();
+        y3.add(x3);
+
+        x3 = t0;
+        x3.mul2();
+        t0.add(x3);
+        t2.mul(b3);
+
+        auto z3 = t1;
+        z3.add(t2);
+        t1.sub(t2);
+        y3.mul(b3);
+
+        x3 = t4;
+        x3.mul(y3);
+        t2 = t3;
+        t2.mul(t1);
+        x3.negate();
+        x3.add(t2);
+
+        y3.mul(t0);
+        t1.mul(z3);
+        y3.add(t1);
+
+        t0.mul(t3);
+        z3.mul(t4);
+        z3.add(t0);
+
+        x = x3;
+        y = y3;
+        z = z3;
+    }
+
+    // Algorithm 8 of RCB15: 11M + 2 mul by 3b
+    void add_mixed_a_is_zero(AffinePoint<E> const &b, WeierstrassCurve<E> const &wc)
+    {
+        auto const &b3 = wc.get_b3();
+
+        auto t0 = x;
+        t0.mul(b.x);
+        auto t1 = y;
+        t1.mul(b.y);
+        auto t3 = b.x;
+        t3.add(b.y);
+
+        auto t4 = x;
+        t4.add(y);
+        t3.mul(t4);
+        t4 = t0;
+        t4.add(t1);
+
+        t3.sub(t4);
+        t4 = b.y;
+        t4.mul(z);
+        t4.add(y);
+
+        auto y3 = b.x;
+        y3.mul(z);
+        y3.add(x);
+        auto x3 = t0;
+        x3.mul2();
+
+        t0.add(x3);
+        auto t2 = z;
+        t2.mul(b3);
+        auto z3 = t1;
+        z3.add(t2);
+
+        t1.sub(t2);
+        y3.mul(b3);
+        x3 = t4;
+        x3.mul(y3);
+
+        t2 = t3;
+        t2.mul(t1);
+        x3.negate();
+        x3.add(t2);
+        y3.mul(t0);
+
+        t1.mul(z3);
+        y3.add(t1);
+        t0.mul(t3);
+
+        z3.mul(t4);
+        z3.add(t0);
+
+        x = x3;
+        y = y3;
+        z = z3;
+    }
+
+    // Algorithm 9 of RCB15: 6M + 2S + 1 mul by 3b
+    void mul2_a_is_zero(WeierstrassCurve<E> const &wc)
+    {
+        auto const &b3 = wc.get_b3();
+
+        auto t0 = y;
+        t0.square();
+        auto z3 = t0;
+        z3.mul2();
+        z3.mul2();
+
+        z3.mul2();
+        auto t1 = y;
+        t1.mul(z);
+        auto t2 = z;
+        t2.square();
+
+        t2.mul(b3);
+        auto x3 = t2;
+        x3.mul(z3);
+        auto y3 = t0;
+        y3.add(t2);
+
+        z3.mul(t1);
+        t1 = t2;
+        t1.mul2();
+        t2.add(t1);
+
+        t0.sub(t2);
+        y3.mul(t0);
+        y3.add(x3);
+
+        t1 = x;
+        t1.mul(y);
+        x3 = t0;
+        x3.mul(t1);
+        x3.mul2();
+
+        x = x3;
+        y = y3;
+        z = z3;
+    }
+};
+
 #endif
@@ -13,11 +13,12 @@
 
 class Deserializer
 {
+    std::vector<uint8_t>::const_iterator const start;
     std::vector<uint8_t>::const_iterator begin;
     std::vector<uint8_t>::const_iterator const end;
 
 public:
-    Deserializer(std::vector<std::uint8_t> const &input) : begin(input.cbegin()), end(input.cend()) {}
+    Deserializer(std::vector<std::uint8_t> const &input) : start(input.cbegin()), begin(input.cbegin()), end(input.cend()) {}
 
     // Consumes a byte, throws error otherwise
     u8 byte(str &err)
@@ -82,6 +83,12 @@ public:
         }
     }
 
+    // Bytes consumed so far, identifies everything decoded from them (e.g. as a cache key)
+    std::string consumed() const
+    {
+        return std::string(start, begin);
+    }
+
     bool ended() const
     {
         return begin == end;
@@ -365,11 +372,11 @@ u64 inline num_units_for_group_order_length(const u64 order_length)
 }
 
 template <class F, class C>
-CurvePoint<F> inline deserialize_curve_point(u8 mod_byte_len, C const &field, WeierstrassCurve<F> const &wc, Deserializer &deserializer)
+AffinePoint<F> inline deserialize_curve_point(u8 mod_byte_len, C const &field, WeierstrassCurve<F> const &wc, Deserializer &deserializer)
 {
     F x = deserialize_fpM(mod_byte_len, field, deserializer);
     F y = deserialize_fpM(mod_byte_len, field, deserializer);
-    auto const cp = CurvePoint(x, y);
+    auto const cp = AffinePoint(x, y);
 
     if (!cp.check_on_curve(wc))
     {
@@ -383,16 +390,16 @@ CurvePoint<F> inline deserialize_curve_point(u8 mod_byte_len, C const &field, We
 
 // ********************** POINTS deserialization ******************************* //
 template <usize N, class F, class C>
-std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<F>>> inline deserialize_points(u8 mod_byte_len, C const &field, WeierstrassCurve<Fp<N>> const &g1_curve, WeierstrassCurve<F> const &g2_curve, Deserializer &deserializer)
+std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<F>>> inline deserialize_points(u8 mod_byte_len, C const &field, WeierstrassCurve<Fp<N>> const &g1_curve, WeierstrassCurve<F> const &g2_curve, Deserializer &deserializer)
 {
-    // deser (CurvePoint<Fp<N>>,CurvePoint<F>) pairs
+    // deser (AffinePoint<Fp<N>>,AffinePoint<F>) pairs
     auto const num_pairs = deserializer.byte("Input is not long enough to get number of pairs");
     if (num_pairs == 0)
     {
         input_err("Zero pairs encoded");
     }
 
-    std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<F>>> points;
+    std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<F>>> points;
     for (auto i = 0; i < num_pairs; i++)
     {
         auto const subgroup_check_g1 = deserialize_boolean(deserializer);
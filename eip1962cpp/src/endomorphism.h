@@ -0,0 +1,284 @@
+#ifndef H_ENDOMORPHISM
+#define H_ENDOMORPHISM
+
+#include <atomic>
+
+#include "common.h"
+#include "constants.h"
+#include "curve.h"
+#include "cache.h"
+
+/*
+Endomorphism split of multiexp scalars (GLV) for curves with A = 0 over Fp with p = 1 mod 3.
+
+Such curves have the endomorphism phi(x, y) = (beta * x, y) for a cube root of unity beta in Fp, which acts on points
+of prime order r as multiplication by a cube root of unity lambda mod r. A scalar k is written as k1 + k2 * lambda mod r
+with k1 and k2 of about half the bits of r, so the pair (P, k) becomes (P, k1), (phi(P), k2).
+phi(P) = lambda * P only holds in the subgroup of order r, so the split is off unless the caller enables it for inputs
+known to be in the subgroup. Parameters are found on the first point of an input and cached per curve.
+*/
+
+// g^((p - 1) / 3) for the first small g that is not a cube, if p = 1 mod 3
+template <usize N>
+Option<Fp<N>> cube_root_of_unity(PrimeField<N> const &field)
+{
+    constexpr Repr<N> one = {1};
+    constexpr Repr<N> three = {3};
+    auto const division = cbn::div(cbn::subtract_ignore_carry(field.mod(), one), three);
+    if (!cbn::is_zero(division.remainder))
+    {
+        return {};
+    }
+    for (u64 g = 2; g < 32; g++)
+    {
+        Repr<N> const base = {g};
+        if (!(base < field.mod()))
+        {
+            break;
+        }
+        auto const root = Fp<N>::from_repr(base, field).pow(division.quotient);
+        if (root != Fp<N>::one(field))
+        {
+            return root;
+        }
+    }
+    return {};
+}
+
+// Parameters of the split for one curve. Limbs only, so that they do not depend on the field of the call that found them.
+template <usize N>
+struct Endomorphism
+{
+    Repr<N> order;
+    // Montgomery limbs of beta
+    Repr<N> beta;
+    // Short basis (a1, b1), (a2, b2) of the lattice {(a, b) : a + b * lambda = 0 mod r}, with determinant +-r
+    SignedRepr<N> a1;
+    SignedRepr<N> b1;
+    SignedRepr<N> a2;
+    SignedRepr<N> b2;
+    bool det_negative;
+
+    // k = k1 + k2 * lambda mod r: (k, 0) minus the closest lattice vector c1 * (a1, b1) + c2 * (a2, b2),
+    // where (c1, c2) = (b2 * k, -b1 * k) / det rounded to the nearest integers
+    std::pair<SignedRepr<N>, SignedRepr<N>> decompose(Repr<N> k) const
+    {
+        k = cbn::div(k, order).remainder;
+        SignedRepr<N> const c1{rounded_quotient(b2.magnitude, k), b2.negative != det_negative};
+        SignedRepr<N> const c2{rounded_quotient(b1.magnitude, k), b1.negative == det_negative};
+
+        auto const k1 = signed_sub(signed_sub(SignedRepr<N>{k, false}, signed_mul(c1, a1)), signed_mul(c2, a2));
+        auto const k2 = signed_add(signed_mul(c1, b1), signed_mul(c2, b2));
+        return std::make_pair(k1, SignedRepr<N>{k2.magnitude, !k2.negative});
+    }
+
+private:
+    // round(x * k / r)
+    Repr<N> rounded_quotient(Repr<N> const &x, Repr<N> const &k) const
+    {
+        auto const product = cbn::add_ignore_carry(cbn::mul(x, k), cbn::detail::pad<N>(cbn::shift_right(order, 1)));
+        return cbn::detail::first<N>(cbn::div(product, order).quotient);
+    }
+};
+
+// Short basis of the lattice from the extended Euclidean algorithm on r and lambda (Guide to Elliptic Curve
+// Cryptography, algorithm 3.74). Every remainder r_i = s_i * r + t_i * lambda gives the lattice vector (r_i, -t_i),
+// signs of t_i alternate with t_1 = 1, so only magnitudes are kept.
+template <usize N>
+void endomorphism_basis(Repr<N> const &lambda, Endomorphism<N> &e)
+{
+    std::vector<Repr<N>> remainders = {e.order, lambda};
+    std::vector<Repr<N>> t = {Repr<N>{0}, Repr<N>{1}};
+    while (!cbn::is_zero(remainders.back()))
+    {
+        auto const i = remainders.size() - 1;
+        auto const division = cbn::div(remainders[i - 1], remainders[i]);
+        remainders.push_back(division.remainder);
+        t.push_back(cbn::add_ignore_carry(t[i - 1], cbn::partial_mul<N>(division.quotient, t[i])));
+    }
+
+    // -t_i is negative for odd i
+    auto const vector = [&](usize i) {
+        return std::make_pair(SignedRepr<N>{remainders[i], false}, SignedRepr<N>{t[i], i % 2 == 1});
+    };
+    auto const norm = [&](usize i) {
+        return cbn::add_ignore_carry(cbn::mul(remainders[i], remainders[i]), cbn::mul(t[i], t[i]));
+    };
+
+    // l is the last index with r_l >= sqrt(r), the remainders end with zero so l + 1 exists
+    usize l = 0;
+    while (!(cbn::mul(remainders[l + 1], remainders[l + 1]) < e.order))
+    {
+        l++;
+    }
+
+    std::tie(e.a1, e.b1) = vector(l + 1);
+    if (l + 2 < remainders.size() && norm(l + 2) < norm(l))
+    {
+        std::tie(e.a2, e.b2) = vector(l + 2);
+    }
+    else
+    {
+        std::tie(e.a2, e.b2) = vector(l);
+    }
+    e.det_negative = signed_sub(signed_mul(e.a1, e.b2), signed_mul(e.a2, e.b1)).negative;
+}
+
+// Finds beta and lambda and checks phi(P) = lambda * P on the point, which must not be the point at infinity
+template <usize N>
+std::shared_ptr<Endomorphism<N> const> find_endomorphism(AffinePoint<Fp<N>> const &point, WeierstrassCurve<Fp<N>> const &wc, PrimeField<N> const &field)
+{
+    auto const order = repr_from_limbs<N>(wc.subgroup_order());
+    // Sums in decompose take up to two bits above r, arithmetic mod r needs an odd r
+    if (!order || cbn::detail::bit_length(order.value()) + 2 > N * LIMB_BITS || is_even(order.value()))
+    {
+        return nullptr;
+    }
+
+    auto const beta = cube_root_of_unity(field);
+    auto const scalar_field = PrimeField<N>(order.value());
+    auto const lambda_root = cube_root_of_unity(scalar_field);
+    if (!beta || !lambda_root)
+    {
+        return nullptr;
+    }
+    auto const lambda = lambda_root.value().into_repr();
+
+    // lambda goes with beta or with beta^2
+    auto const expected = point.mul(std::vector<u64>(lambda.cbegin(), lambda.cend()), wc, field).into_affine();
+    auto candidate = beta.value();
+    for (usize i = 0; i < 2; i++)
+    {
+        auto x = point.x;
+        x.mul(candidate);
+        if (x == expected.x && point.y == expected.y)
+        {
+            auto e = std::make_shared<Endomorphism<N>>();
+            e->order = order.value();
+            e->beta = candidate.representation();
+            endomorphism_basis(lambda, *e);
+            return e;
+        }
+        candidate.square();
+    }
+    return nullptr;
+}
+
+// Switch of the split, off by default
+class EndomorphismSettings
+{
+public:
+    static EndomorphismSettings &getInstance()
+    {
+        static EndomorphismSettings instance;
+        return instance;
+    }
+
+    std::atomic<bool> enabled;
+
+private:
+    EndomorphismSettings() : enabled(false) {}
+    ~EndomorphismSettings() = default;
+    EndomorphismSettings(const EndomorphismSettings &) = delete;
+    EndomorphismSettings &operator=(const EndomorphismSettings &) = delete;
+};
+
+// Process wide cache of parameters per curve, for curves over fields of N limbs
+template <usize N>
+class EndomorphismCache
+{
+public:
+    static EndomorphismCache &getInstance()
+    {
+        static EndomorphismCache instance;
+        return instance;
+    }
+
+    LruCache<Endomorphism<N>> parameters;
+
+    // Modulus, B and the order identify the curve
+    static std::string key(WeierstrassCurve<Fp<N>> const &wc, PrimeField<N> const &field)
+    {
+        auto const modulus = field.mod();
+        auto const b = wc.get_b().representation();
+        std::string res(reinterpret_cast<char const *>(modulus.data()), N * sizeof(u64));
+        res.append(reinterpret_cast<char const *>(b.data()), N * sizeof(u64));
+        res.append(reinterpret_cast<char const *>(wc.subgroup_order().data()), wc.subgroup_order().size() * sizeof(u64));
+        return res;
+    }
+
+private:
+    EndomorphismCache() : parameters(ENDOMORPHISM_CACHE_MAX_BYTES) {}
+    ~EndomorphismCache() = default;
+    EndomorphismCache(const EndomorphismCache &) = delete;
+    EndomorphismCache &operator=(const EndomorphismCache &) = delete;
+};
+
+// Curves over extensions have no split
+template <class E, class C>
+bool endomorphism_split(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &, WeierstrassCurve<E> const &, C const &, std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> &)
+{
+    return false;
+}
+
+// Replaces every pair (P, k) by (P, k1) and (phi(P), k2) in split, where points of negative halves are negated.
+// Returns false if the curve has no such endomorphism or it does not hold for the first point of the input.
+template <usize N>
+bool endomorphism_split(std::vector<std::tuple<AffinePoint<Fp<N>>, std::vector<u64>>> const &pairs, WeierstrassCurve<Fp<N>> const &wc, PrimeField<N> const &field, std::vector<std::tuple<AffinePoint<Fp<N>>, std::vector<u64>>> &split)
+{
+    if (wc.ctype() != CurveType::AIsZero)
+    {
+        return false;
+    }
+
+    auto &cache = EndomorphismCache<N>::getInstance();
+    auto const key = EndomorphismCache<N>::key(wc, field);
+    auto endomorphism = cache.parameters.get(key);
+    if (!endomorphism)
+    {
+        for (auto const &pair : pairs)
+        {
+            if (!std::get<0>(pair).is_zero())
+            {
+                endomorphism = find_endomorphism(std::get<0>(pair), wc, field);
+                break;
+            }
+        }
+        if (!endomorphism)
+        {
+            return false;
+        }
+        cache.parameters.put(key, endomorphism, key.size() + sizeof(Endomorphism<N>));
+    }
+
+    auto const beta = Fp<N>(endomorphism->beta, field);
+    split.clear();
+    split.reserve(2 * pairs.size());
+    for (auto const &pair : pairs)
+    {
+        auto const scalar = repr_from_limbs<N>(std::get<1>(pair));
+        if (!scalar)
+        {
+            split.clear();
+            return false;
+        }
+        auto const halves = endomorphism->decompose(scalar.value());
+
+        auto point = std::get<0>(pair);
+        auto image = point;
+        image.x.mul(beta);
+        if (halves.first.negative)
+        {
+            point.negate();
+        }
+        if (halves.second.negative)
+        {
+            image.negate();
+        }
+        split.emplace_back(point, std::vector<u64>(halves.first.magnitude.cbegin(), halves.first.magnitude.cend()));
+        split.emplace_back(image, std::vector<u64>(halves.second.magnitude.cbegin(), halves.second.magnitude.cend()));
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef H_FIXED_BASE
+#define H_FIXED_BASE
+
+#include <atomic>
+
+#include "common.h"
+#include "constants.h"
+#include "curve.h"
+#include "cache.h"
+
+/*
+Fixed base multiplication for bases that are multiplied repeatedly (generators, verifying key points).
+
+For window width w the table holds d * 2^(w*j) * P for every window j and digit d in 1..2^w-1, in affine form.
+A multiplication is then one mixed addition per non-zero digit of the scalar and no doublings.
+Tables are built once a base was seen FIXED_BASE_CACHE_THRESHOLD times and are kept in a bounded LRU cache.
+*/
+
+static_assert(64 % FIXED_BASE_WINDOW == 0, "fixed base windows must not cross limbs");
+
+// Table for one base, stored as limbs so that it does not depend on the field of the call that built it
+class FixedBaseTable
+{
+public:
+    usize const window;
+    usize const windows;
+    usize const point_limbs;
+    std::vector<u64> const limbs;
+
+    FixedBaseTable(usize window, usize windows, usize point_limbs, std::vector<u64> limbs) : window(window), windows(windows), point_limbs(point_limbs), limbs(limbs) {}
+
+    usize bytes() const
+    {
+        return limbs.size() * sizeof(u64) + sizeof(FixedBaseTable);
+    }
+
+    usize digits() const
+    {
+        return (usize(1) << window) - 1;
+    }
+
+    template <class E, class C>
+    AffinePoint<E> point(usize window_index, usize digit, C const &context) const
+    {
+        constexpr auto element_limbs = ElementLimbs<E>::count;
+        auto const src = limbs.data() + (window_index * digits() + digit - 1) * point_limbs;
+        return AffinePoint(ElementLimbs<E>::load(src, context), ElementLimbs<E>::load(src + element_limbs, context));
+    }
+};
+
+template <class E, class C>
+std::shared_ptr<FixedBaseTable const> build_fixed_base_table(AffinePoint<E> const &base, usize scalar_bits, usize window, WeierstrassCurve<E> const &wc, C const &context)
+{
+    auto const windows = (scalar_bits + window - 1) / window;
+    auto const digits = (usize(1) << window) - 1;
+
+    std::vector<CurvePoint<E>> multiples;
+    multiples.reserve(windows * digits);
+
+    // 2^(w*j) * P
+    auto window_base = CurvePoint<E>(base);
+    for (usize j = 0; j < windows; j++)
+    {
+        auto multiple = window_base;
+        multiples.push_back(multiple);
+        for (usize d = 1; d < digits; d++)
+        {
+            multiple.add(window_base, wc, context);
+            multiples.push_back(multiple);
+        }
+        for (usize i = 0; i < window; i++)
+        {
+            window_base.mul2(wc);
+        }
+    }
+
+    auto const affine = batch_into_affine(multiples);
+
+    constexpr auto element_limbs = ElementLimbs<E>::count;
+    std::vector<u64> limbs(affine.size() * 2 * element_limbs);
+    for (usize i = 0; i < affine.size(); i++)
+    {
+        ElementLimbs<E>::store(affine[i].x, limbs.data() + 2 * i * element_limbs);
+        ElementLimbs<E>::store(affine[i].y, limbs.data() + (2 * i + 1) * element_limbs);
+    }
+
+    return std::make_shared<FixedBaseTable const>(window, windows, 2 * element_limbs, limbs);
+}
+
+// Digit of the scalar in the window starting at the given bit, windows never cross a limb as the width divides 64
+u64 inline fixed_base_digit(std::vector<u64> const &scalar, usize bit, usize window)
+{
+    auto const limb = bit / 64;
+    if (limb >= scalar.size())
+    {
+        return 0;
+    }
+    return (scalar[limb] >> (bit % 64)) & ((u64(1) << window) - 1);
+}
+
+template <class E, class C>
+CurvePoint<E> fixed_base_mul(FixedBaseTable const &table, std::vector<u64> const &scalar, WeierstrassCurve<E> const &wc, C const &context)
+{
+    auto res = CurvePoint<E>::zero(context);
+    for (usize j = 0; j < table.windows; j++)
+    {
+        auto const digit = fixed_base_digit(scalar, j * table.window, table.window);
+        if (digit != 0)
+        {
+            res.add_mixed(table.point<E>(j, digit, context), wc, context);
+        }
+    }
+
+    return res;
+}
+
+// Process wide cache of fixed base tables and of how many times every base was seen
+class FixedBaseCache
+{
+public:
+    static FixedBaseCache &getInstance()
+    {
+        static FixedBaseCache instance;
+        return instance;
+    }
+
+    LruCache<FixedBaseTable> tables;
+    LruCache<u32> seen;
+    std::atomic<u32> threshold;
+
+private:
+    FixedBaseCache() : tables(FIXED_BASE_CACHE_MAX_BYTES), seen(FIXED_BASE_SEEN_MAX_BYTES), threshold(FIXED_BASE_CACHE_THRESHOLD) {}
+    ~FixedBaseCache() = default;
+    FixedBaseCache(const FixedBaseCache &) = delete;
+    FixedBaseCache &operator=(const FixedBaseCache &) = delete;
+};
+
+// Multiplies the base through the cache. key must identify the curve and the base, e.g. all input bytes before the scalar.
+template <class E, class C>
+CurvePoint<E> cached_mul(std::string const &key, AffinePoint<E> const &base, std::vector<u64> const &scalar, WeierstrassCurve<E> const &wc, C const &context)
+{
+    auto &cache = FixedBaseCache::getInstance();
+    auto const scalar_bits = scalar.size() * 64;
+
+    if (auto const table = cache.tables.get(key))
+    {
+        if (table->windows * table->window >= scalar_bits)
+        {
+            return fixed_base_mul(*table, scalar, wc, context);
+        }
+    }
+
+    if (cache.tables.capacity() == 0)
+    {
+        return base.mul(scalar, wc, context);
+    }
+
+    auto const seen = cache.seen.get(key);
+    u32 const count = seen ? *seen + 1 : 1;
+    if (count < cache.threshold)
+    {
+        cache.seen.put(key, std::make_shared<u32 const>(count), key.size() + sizeof(u32));
+        return base.mul(scalar, wc, context);
+    }
+
+    auto const table = build_fixed_base_table(base, scalar_bits, FIXED_BASE_WINDOW, wc, context);
+    cache.tables.put(key, table, key.size() + table->bytes());
+
+    return fixed_base_mul(*table, scalar, wc, context);
+}
+
+#endif
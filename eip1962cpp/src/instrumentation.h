@@ -0,0 +1,97 @@
+#ifndef H_INSTRUMENTATION
+#define H_INSTRUMENTATION
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/*
+Process wide counters of decisions taken inside the library, so that they can be checked on production inputs.
+Counting is a relaxed atomic increment per call.
+*/
+
+static const std::size_t MULTIEXP_MAX_WINDOW = 16;
+
+struct MultiexpStats
+{
+    std::uint64_t straus_calls;
+    std::uint64_t pippenger_calls;
+    // Pippenger calls with batch affine buckets
+    std::uint64_t batch_affine_calls;
+    // Pippenger calls over scalars split with the curve endomorphism
+    std::uint64_t endomorphism_calls;
+    // Number of calls per window width
+    std::array<std::uint64_t, MULTIEXP_MAX_WINDOW + 1> straus_windows;
+    std::array<std::uint64_t, MULTIEXP_MAX_WINDOW + 1> pippenger_windows;
+};
+
+class MultiexpCounters
+{
+    std::array<std::atomic<std::uint64_t>, MULTIEXP_MAX_WINDOW + 1> straus_windows;
+    std::array<std::atomic<std::uint64_t>, MULTIEXP_MAX_WINDOW + 1> pippenger_windows;
+    std::atomic<std::uint64_t> batch_affine_calls;
+    std::atomic<std::uint64_t> endomorphism_calls;
+
+public:
+    static MultiexpCounters &getInstance()
+    {
+        static MultiexpCounters instance;
+        return instance;
+    }
+
+    void record_straus(std::size_t window)
+    {
+        straus_windows[window].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_pippenger(std::size_t window, bool batch_affine)
+    {
+        pippenger_windows[window].fetch_add(1, std::memory_order_relaxed);
+        if (batch_affine)
+        {
+            batch_affine_calls.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void record_endomorphism()
+    {
+        endomorphism_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MultiexpStats stats() const
+    {
+        MultiexpStats result{};
+        result.batch_affine_calls = batch_affine_calls.load(std::memory_order_relaxed);
+        result.endomorphism_calls = endomorphism_calls.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i <= MULTIEXP_MAX_WINDOW; i++)
+        {
+            result.straus_windows[i] = straus_windows[i].load(std::memory_order_relaxed);
+            result.pippenger_windows[i] = pippenger_windows[i].load(std::memory_order_relaxed);
+            result.straus_calls += result.straus_windows[i];
+            result.pippenger_calls += result.pippenger_windows[i];
+        }
+        return result;
+    }
+
+    void reset()
+    {
+        batch_affine_calls.store(0, std::memory_order_relaxed);
+        endomorphism_calls.store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i <= MULTIEXP_MAX_WINDOW; i++)
+        {
+            straus_windows[i].store(0, std::memory_order_relaxed);
+            pippenger_windows[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    MultiexpCounters()
+    {
+        reset();
+    }
+    ~MultiexpCounters() = default;
+    MultiexpCounters(const MultiexpCounters &) = delete;
+    MultiexpCounters &operator=(const MultiexpCounters &) = delete;
+};
+
+#endif
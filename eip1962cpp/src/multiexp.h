@@ -1,76 +1,575 @@
 #ifndef H_MULTIEXP
 #define H_MULTIEXP
 
+#include <cmath>
+
 #include "curve.h"
 #include "common.h"
+#include "constants.h"
+#include "cache.h"
+#include "endomorphism.h"
+#include "instrumentation.h"
+#include "pippenger_costs.h"
+#include "thread_pool.h"
 
-template <class E, class C>
-CurvePoint<E> peepinger(std::vector<std::tuple<CurvePoint<E>, std::vector<u64>>> pairs, WeierstrassCurve<E> const &wc, C const &context)
+template <class E>
+usize max_scalar_bits(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs)
 {
-    u32 c;
-    if (pairs.size() < 32)
+    usize bits = 0;
+    for (auto const &pair : pairs)
     {
-        c = 3;
+        bits = std::max(bits, usize(num_bits(std::get<1>(pair))));
     }
-    else
+    return bits;
+}
+
+// Window width and bucket representation of a Pippenger run
+struct PippengerPlan
+{
+    usize window;
+    // Affine buckets filled in rounds of additions that share one inversion, instead of Jacobian buckets
+    bool batch_affine;
+};
+
+// Expected cost of Pippenger, in mixed additions. Digits are signed, so every window has 2^(c-1) buckets
+// and one more window may be needed for the carry out of the top one. Every window adds each point with a non-zero digit
+// to its bucket, where the first point of a bucket is only a copy, sums the buckets with two additions per bucket
+// and is merged into the result with c doublings and one addition.
+// With batch affine buckets a bucket addition costs batch_add and every round of additions one inversion. Rounds run over
+// all windows at once, there are about as many as points in the fullest bucket. Buckets are then summed with mixed additions.
+double inline pippenger_cost(usize pairs, usize scalar_bits, PippengerPlan const &plan, PointCosts const &costs)
+{
+    auto const c = plan.window;
+    double const windows = double(scalar_bits / c + 1);
+    double const buckets = double(usize(1) << (c - 1));
+    // Digits are close to uniform over -2^(c-1)..2^(c-1)
+    double const bucket_hits = double(pairs) * (1 - 1 / (2 * buckets));
+    double const filled_buckets = buckets * (1 - std::pow(1 - 1 / buckets, bucket_hits));
+    double const bucket_adds = bucket_hits - filled_buckets;
+    double const merge = double(c) * costs.mul2 + costs.add;
+
+    if (!plan.batch_affine)
+    {
+        return windows * (bucket_adds + 2 * buckets * costs.add + merge);
+    }
+
+    double const load = bucket_hits / buckets;
+    double const rounds = load + 2 * std::sqrt(load) + 1;
+    return rounds * costs.inverse + windows * (bucket_adds * costs.batch_add + buckets * (1 + costs.add) + merge);
+}
+
+// Plan that minimizes pippenger_cost with the point costs calibrated for this field
+template <class E>
+PippengerPlan pippenger_plan(usize pairs, usize scalar_bits, u8 extension_degree, WeierstrassCurve<E> const &wc)
+{
+    auto const limbs = ElementLimbs<E>::count / extension_degree;
+    auto const costs = pippenger_point_costs(limbs, extension_degree, wc.ctype() == CurveType::AIsZero);
+
+    PippengerPlan best{1, false};
+    auto best_cost = pippenger_cost(pairs, scalar_bits, best, costs);
+    for (usize c = 1; c <= MULTIEXP_MAX_WINDOW; c++)
+    {
+        for (bool batch_affine : {false, true})
+        {
+            PippengerPlan const plan{c, batch_affine};
+            auto const cost = pippenger_cost(pairs, scalar_bits, plan, costs);
+            if (cost < best_cost)
+            {
+                best = plan;
+                best_cost = cost;
+            }
+        }
+    }
+    return best;
+}
+
+// Cost of the plan chosen by pippenger_plan
+template <class E>
+double pippenger_plan_cost(usize pairs, usize scalar_bits, u8 extension_degree, WeierstrassCurve<E> const &wc)
+{
+    auto const limbs = ElementLimbs<E>::count / extension_degree;
+    auto const costs = pippenger_point_costs(limbs, extension_degree, wc.ctype() == CurveType::AIsZero);
+    return pippenger_cost(pairs, scalar_bits, pippenger_plan(pairs, scalar_bits, extension_degree, wc), costs);
+}
+
+// Signed digits of all scalars of a run, window major so that a bucket pass reads its digits in order:
+// digit j of scalar i is at j * points + i
+struct PippengerDigits
+{
+    usize points;
+    usize windows;
+    std::vector<i32> digits;
+
+    i32 const *window(usize j) const
+    {
+        return digits.data() + j * points;
+    }
+};
+
+// Decomposes all scalars in one pass straight into the flat array, windows is the number of digits of the longest scalar
+template <class E>
+PippengerDigits pippenger_digits(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs, usize c)
+{
+    // The top digit may carry into one more window
+    auto const max_windows = (max_scalar_bits(pairs) + c - 1) / c + 1;
+    PippengerDigits res{pairs.size(), 0, std::vector<i32>(max_windows * pairs.size(), 0)};
+    for (usize i = 0; i < pairs.size(); i++)
+    {
+        res.windows = std::max(res.windows, into_signed_digits(std::get<1>(pairs[i]), c, res.digits.data() + i, pairs.size()));
+    }
+    res.digits.resize(res.windows * pairs.size());
+    return res;
+}
+
+template <class E>
+std::vector<AffinePoint<E>> negated_points(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs)
+{
+    std::vector<AffinePoint<E>> negated;
+    negated.reserve(pairs.size());
+    for (auto const &pair : pairs)
     {
-        c = ceil(log((double)pairs.size()));
-    };
+        negated.push_back(std::get<0>(pair));
+        negated.back().negate();
+    }
+    return negated;
+}
 
-    std::vector<CurvePoint<E>> windows;
-    std::vector<CurvePoint<E>> buckets;
+// Part of a Pippenger run: the sums of windows window_begin..window_end-1 over points point_begin..point_end-1
+struct PippengerTask
+{
+    usize window_begin;
+    usize window_end;
+    usize point_begin;
+    usize point_end;
+};
 
-    u64 mask = (u64(1) << c) - u64(1);
-    u32 cur = 0;
-    auto const n_bits = num_bits(wc.subgroup_order());
-    auto const zero_point = CurvePoint<E>::zero(context);
+// Splits a run over the threads of the pool. Windows are independent and split first. When there are fewer windows
+// than threads and enough points, every group of windows is also split into point chunks with their own buckets.
+// Tasks are ordered by window and then by chunk, and the caller combines them in this order.
+std::vector<PippengerTask> inline pippenger_tasks(usize windows, usize points, usize threads)
+{
+    auto const groups = std::max(usize(1), std::min(windows, threads));
+    usize chunks = 1;
+    if (windows < threads)
+    {
+        chunks = std::max(usize(1), std::min((threads + groups - 1) / groups, points / MULTIEXP_PARALLEL_MIN_CHUNK));
+    }
 
-    while (cur <= n_bits)
+    std::vector<PippengerTask> tasks;
+    tasks.reserve(groups * chunks);
+    for (usize g = 0; g < groups; g++)
     {
-        auto acc = zero_point;
+        for (usize k = 0; k < chunks; k++)
+        {
+            tasks.push_back(PippengerTask{g * windows / groups, (g + 1) * windows / groups, k * points / chunks, (k + 1) * points / chunks});
+        }
+    }
+    return tasks;
+}
 
-        buckets.resize(0, zero_point);
-        buckets.resize((1 << c) - 1, zero_point);
+// Runs the tasks on the thread pool, where window_sums(task) returns the sums of the windows of the task,
+// and adds them to sums in task order, which grows to the windows of the tasks.
+// The order of additions depends only on the tasks, so the result does not depend on which thread ran what.
+template <class P, class E, class C, class F>
+void accumulate_pippenger_tasks(std::vector<PippengerTask> const &tasks, std::vector<P> &sums, WeierstrassCurve<E> const &wc, C const &context, F const &window_sums)
+{
+    std::vector<std::vector<P>> results(tasks.size());
+    ThreadPool::getInstance().run(tasks.size(), [&](usize t) { results[t] = window_sums(tasks[t]); });
+
+    for (usize t = 0; t < tasks.size(); t++)
+    {
+        if (sums.size() < tasks[t].window_end)
+        {
+            sums.resize(tasks[t].window_end, P::zero(context));
+        }
+        for (usize j = tasks[t].window_begin; j < tasks[t].window_end; j++)
+        {
+            sums[j].add(results[t][j - tasks[t].window_begin], wc, context);
+        }
+    }
+}
 
-        for (auto it = pairs.begin(); it != pairs.end(); it++)
+// Merges window sums from the top one with c doublings each
+template <class P, class E, class C>
+P merge_pippenger_windows(std::vector<P> const &sums, usize c, WeierstrassCurve<E> const &wc, C const &context)
+{
+    auto acc = P::zero(context);
+    for (usize j = sums.size(); j-- > 0;)
+    {
+        for (u32 i = 0; i < c; i++)
         {
-            CurvePoint<E> const &g = std::get<0>(*it);
-            std::vector<u64> &s = std::get<1>(*it);
-            usize const index = s[0] & mask;
+            acc.mul2(wc);
+        }
+        acc.add(sums[j], wc, context);
+    }
+    return acc;
+}
+
+template <class P, class E, class C, class F>
+P combine_pippenger_tasks(std::vector<PippengerTask> const &tasks, usize windows, usize c, WeierstrassCurve<E> const &wc, C const &context, F const &window_sums)
+{
+    std::vector<P> sums(windows, P::zero(context));
+    accumulate_pippenger_tasks(tasks, sums, wc, context, window_sums);
+    return merge_pippenger_windows(sums, c, wc, context);
+}
+
+// Window sums of a task with buckets of type P. points(i) is the i-th base and negated[i] its negation.
+template <template <class> class P, class E, class C, class Points>
+std::vector<P<E>> bucket_window_sums(Points const &points, std::vector<AffinePoint<E>> const &negated, PippengerDigits const &digits, PippengerTask const &task, usize c, WeierstrassCurve<E> const &wc, C const &context)
+{
+    usize const bucket_count = usize(1) << (c - 1);
+    auto const zero_point = P<E>::zero(context);
+    // Reused by every window of the task
+    std::vector<P<E>> buckets(bucket_count, zero_point);
+    std::vector<P<E>> sums;
+    sums.reserve(task.window_end - task.window_begin);
+
+    for (usize j = task.window_begin; j < task.window_end; j++)
+    {
+        std::fill(buckets.begin(), buckets.end(), zero_point);
+        auto const window_digits = digits.window(j);
 
-            if (index != 0)
+        for (usize i = task.point_begin; i < task.point_end; i++)
+        {
+            auto const digit = window_digits[i];
+            if (digit > 0)
             {
-                buckets[index - 1].add_mixed(g, wc, context);
+                buckets[digit - 1].add_mixed(points(i), wc, context);
+            }
+            else if (digit < 0)
+            {
+                buckets[-digit - 1].add_mixed(negated[i], wc, context);
             }
-
-            right_shift(s, c);
         }
 
+        auto sum = zero_point;
         auto running_sum = zero_point;
         for (auto it = buckets.crbegin(); it != buckets.crend(); it++)
         {
             running_sum.add(*it, wc, context);
-            acc.add(running_sum, wc, context);
+            sum.add(running_sum, wc, context);
         }
+        sums.push_back(sum);
+    }
+    return sums;
+}
 
-        windows.push_back(acc);
+// Window sums of a task with affine buckets. The buckets of all windows of the task are filled together in rounds,
+// every round does at most one addition per bucket and all additions of a round share one inversion.
+// Additions into a bucket that already has one in the current round wait for the next round.
+template <class E, class C, class Points>
+std::vector<CurvePoint<E>> batch_affine_window_sums(Points const &points, std::vector<AffinePoint<E>> const &negated, PippengerDigits const &digits, PippengerTask const &task, usize c, WeierstrassCurve<E> const &wc, C const &context)
+{
+    usize const bucket_count = usize(1) << (c - 1);
+    auto const task_windows = task.window_end - task.window_begin;
+    std::vector<AffinePoint<E>> buckets(task_windows * bucket_count, AffinePoint<E>::zero(context));
 
-        cur += c;
+    // (bucket, point) where points past digits.points are the negated ones
+    std::vector<std::tuple<u32, u32>> pending;
+    std::vector<std::tuple<u32, u32>> deferred;
+    pending.reserve(task_windows * (task.point_end - task.point_begin));
+    for (usize j = 0; j < task_windows; j++)
+    {
+        auto const window_digits = digits.window(task.window_begin + j);
+        for (usize i = task.point_begin; i < task.point_end; i++)
+        {
+            auto const digit = window_digits[i];
+            if (digit > 0)
+            {
+                pending.push_back(std::tuple(u32(j * bucket_count + usize(digit) - 1), u32(i)));
+            }
+            else if (digit < 0)
+            {
+                pending.push_back(std::tuple(u32(j * bucket_count + usize(-digit) - 1), u32(digits.points + i)));
+            }
+        }
     }
 
-    auto acc = zero_point;
+    // Round in which a bucket last got a pending addition
+    std::vector<u32> busy(buckets.size(), 0);
+    u32 round = 0;
+    BatchAffineAdder<E> adder;
+    while (!pending.empty())
+    {
+        round++;
+        deferred.clear();
+        for (auto const &[bucket, point] : pending)
+        {
+            if (busy[bucket] == round)
+            {
+                deferred.push_back(std::tuple(bucket, point));
+                continue;
+            }
+
+            auto const &source = point < digits.points ? points(point) : negated[point - digits.points];
+            if (adder.add(buckets[bucket], source, wc))
+            {
+                busy[bucket] = round;
+            }
+        }
+        adder.run();
+        std::swap(pending, deferred);
+    }
 
-    for (auto it = windows.crbegin(); it != windows.crend(); it++)
+    std::vector<CurvePoint<E>> sums;
+    sums.reserve(task_windows);
+    for (usize j = 0; j < task_windows; j++)
     {
-        for (u32 i = 0; i < c; i++)
+        auto sum = CurvePoint<E>::zero(context);
+        auto running_sum = CurvePoint<E>::zero(context);
+        for (usize k = bucket_count; k-- > 0;)
         {
-            acc.mul2(wc);
+            running_sum.add_mixed(buckets[j * bucket_count + k], wc, context);
+            sum.add(running_sum, wc, context);
+        }
+        sums.push_back(sum);
+    }
+    return sums;
+}
+
+// Pippenger with signed digits: a digit d < 0 adds -P to bucket |d|, which halves the buckets of a window.
+// P: accumulator point type for buckets and windows, CurvePoint (Jacobian) or ProjectivePoint (complete formulas)
+// c: window width, at most MULTIEXP_MAX_WINDOW
+// Windows, and point chunks of large inputs, are spread over the threads of ThreadPool.
+template <template <class> class P = CurvePoint, class E, class C>
+P<E> peepinger(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs, WeierstrassCurve<E> const &wc, C const &context, usize c)
+{
+    assert(c >= 1 && c <= MULTIEXP_MAX_WINDOW);
+
+    auto const digits = pippenger_digits(pairs, c);
+    auto const negated = negated_points(pairs);
+    auto const points = [&](usize i) -> AffinePoint<E> const & { return std::get<0>(pairs[i]); };
+
+    auto const tasks = pippenger_tasks(digits.windows, digits.points, ThreadPool::getInstance().threads());
+    return combine_pippenger_tasks<P<E>>(tasks, digits.windows, c, wc, context, [&](PippengerTask const &task) {
+        return bucket_window_sums<P>(points, negated, digits, task, c, wc, context);
+    });
+}
+
+// Pippenger with signed digits and batch affine buckets
+template <class E, class C>
+CurvePoint<E> batch_affine_pippenger(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs, WeierstrassCurve<E> const &wc, C const &context, usize c)
+{
+    assert(c >= 1 && c <= MULTIEXP_MAX_WINDOW);
+
+    auto const digits = pippenger_digits(pairs, c);
+    auto const negated = negated_points(pairs);
+    auto const points = [&](usize i) -> AffinePoint<E> const & { return std::get<0>(pairs[i]); };
+
+    auto const tasks = pippenger_tasks(digits.windows, digits.points, ThreadPool::getInstance().threads());
+    return combine_pippenger_tasks<CurvePoint<E>>(tasks, digits.windows, c, wc, context, [&](PippengerTask const &task) {
+        return batch_affine_window_sums(points, negated, digits, task, c, wc, context);
+    });
+}
+
+// Adds the window sums of Pippenger over the pairs to sums, which grows to the number of windows
+template <class E, class C>
+void accumulate_pippenger(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs, WeierstrassCurve<E> const &wc, C const &context, PippengerPlan const &plan, std::vector<CurvePoint<E>> &sums)
+{
+    auto const c = plan.window;
+    assert(c >= 1 && c <= MULTIEXP_MAX_WINDOW);
+
+    auto const digits = pippenger_digits(pairs, c);
+    auto const negated = negated_points(pairs);
+    auto const points = [&](usize i) -> AffinePoint<E> const & { return std::get<0>(pairs[i]); };
+
+    auto const tasks = pippenger_tasks(digits.windows, digits.points, ThreadPool::getInstance().threads());
+    accumulate_pippenger_tasks(tasks, sums, wc, context, [&](PippengerTask const &task) {
+        if (plan.batch_affine)
+        {
+            return batch_affine_window_sums(points, negated, digits, task, c, wc, context);
+        }
+        return bucket_window_sums<CurvePoint>(points, negated, digits, task, c, wc, context);
+    });
+}
+
+template <class E, class C>
+CurvePoint<E> pippenger(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs, WeierstrassCurve<E> const &wc, C const &context, PippengerPlan const &plan)
+{
+    if (plan.batch_affine)
+    {
+        return batch_affine_pippenger(pairs, wc, context, plan.window);
+    }
+    return peepinger(pairs, wc, context, plan.window);
+}
+
+// Straus multiexponentiation with interleaved wNAF. Every point gets an affine table of odd multiples
+// P, 3P, ..., (2^(w-1) - 1)P and all scalars share one chain of doublings.
+template <class E, class C>
+CurvePoint<E> straus(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs, WeierstrassCurve<E> const &wc, C const &context, usize window)
+{
+    assert(window >= 2);
+    usize const table_size = usize(1) << (window - 2);
+
+    std::vector<CurvePoint<E>> multiples;
+    multiples.reserve(pairs.size() * table_size);
+    std::vector<std::vector<i64>> wnafs;
+    wnafs.reserve(pairs.size());
+    usize max_len = 0;
+
+    for (auto const &[p, s] : pairs)
+    {
+        auto const base = CurvePoint<E>(p);
+        auto twice = base;
+        twice.mul2(wc);
+
+        auto multiple = base;
+        multiples.push_back(multiple);
+        for (usize i = 1; i < table_size; i++)
+        {
+            multiple.add(twice, wc, context);
+            multiples.push_back(multiple);
         }
 
-        acc.add(*it, wc, context);
+        wnafs.push_back(into_wnaf(s, window));
+        max_len = std::max(max_len, wnafs.back().size());
+    }
+
+    auto const tables = batch_into_affine(multiples);
+
+    auto acc = CurvePoint<E>::zero(context);
+    for (usize i = max_len; i-- > 0;)
+    {
+        acc.mul2(wc);
+
+        for (usize j = 0; j < pairs.size(); j++)
+        {
+            auto const &wnaf = wnafs[j];
+            if (i >= wnaf.size())
+            {
+                continue;
+            }
+
+            auto const digit = wnaf[i];
+            if (digit > 0)
+            {
+                acc.add_mixed(tables[j * table_size + (usize(digit) >> 1)], wc, context);
+            }
+            else if (digit < 0)
+            {
+                auto negative = tables[j * table_size + (usize(-digit) >> 1)];
+                negative.negate();
+                acc.add_mixed(negative, wc, context);
+            }
+        }
     }
 
     return acc;
 }
 
+// Halves of a split scalar have about half the bits of the order, plus one for the rounding
+template <class E>
+usize endomorphism_split_bits(WeierstrassCurve<E> const &wc)
+{
+    return num_bits(wc.subgroup_order()) / 2 + 1;
+}
+
+// Whether the endomorphism split is enabled for the curve and the input is large enough,
+// and the cost model expects Pippenger over twice the pairs with half the scalar bits to be cheaper
+template <class E>
+bool endomorphism_split_pays(usize pairs, usize scalar_bits, u8 extension_degree, WeierstrassCurve<E> const &wc)
+{
+    if (!EndomorphismSettings::getInstance().enabled || extension_degree != 1 || wc.ctype() != CurveType::AIsZero || pairs < MULTIEXP_ENDOMORPHISM_MIN_PAIRS)
+    {
+        return false;
+    }
+    return pippenger_plan_cost(2 * pairs, endomorphism_split_bits(wc), extension_degree, wc) < pippenger_plan_cost(pairs, scalar_bits, extension_degree, wc);
+}
+
+// Picks Straus or Pippenger by number of pairs, scalar length and extension degree, and the Pippenger window and buckets by its cost model.
+// When the endomorphism split is enabled and applies to the curve, Pippenger over at least MULTIEXP_ENDOMORPHISM_MIN_PAIRS pairs
+// runs over the split pairs if its cost model expects twice the pairs with half the scalar bits to be cheaper.
+// Every decision is counted in MultiexpCounters.
+// Crossovers are measured with `make bench FILTER=straus`: Straus wins up to ~64 pairs over Fp
+// for 254-381 bit scalars, and up to 16-32 pairs for 64 bit scalars or over extensions.
+template <class E, class C>
+CurvePoint<E> multiexp(std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> const &pairs, WeierstrassCurve<E> const &wc, C const &context, u8 extension_degree)
+{
+    auto const scalar_bits = num_bits(wc.subgroup_order());
+
+    usize straus_max_pairs;
+    if (scalar_bits <= 64 || extension_degree != 1)
+    {
+        straus_max_pairs = 24;
+    }
+    else
+    {
+        straus_max_pairs = 64;
+    }
+
+    if (pairs.size() <= straus_max_pairs)
+    {
+        usize const window = scalar_bits <= 64 ? 3 : (scalar_bits <= 128 ? 4 : 5);
+        MultiexpCounters::getInstance().record_straus(window);
+        return straus(pairs, wc, context, window);
+    }
+
+    auto const pairs_bits = max_scalar_bits(pairs);
+    std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> split;
+    if (endomorphism_split_pays(pairs.size(), pairs_bits, extension_degree, wc) && endomorphism_split(pairs, wc, context, split))
+    {
+        auto const plan = pippenger_plan(split.size(), max_scalar_bits(split), extension_degree, wc);
+        MultiexpCounters::getInstance().record_pippenger(plan.window, plan.batch_affine);
+        MultiexpCounters::getInstance().record_endomorphism();
+        return pippenger(split, wc, context, plan);
+    }
+
+    auto const plan = pippenger_plan(pairs.size(), pairs_bits, extension_degree, wc);
+    MultiexpCounters::getInstance().record_pippenger(plan.window, plan.batch_affine);
+    return pippenger(pairs, wc, context, plan);
+}
+
+// Multiexp over num_pairs pairs returned one at a time by next_pair(), for inputs too large to hold at once.
+// Pairs are read in chunks of MULTIEXP_STREAM_CHUNK and every chunk adds its Pippenger window sums to the running ones,
+// so memory depends on the chunk size and not on the number of pairs. Inputs of up to one chunk go through multiexp().
+// Chunks are split with the curve endomorphism when multiexp() would split a full chunk.
+template <class E, class C, class F>
+CurvePoint<E> streaming_multiexp(usize num_pairs, F const &next_pair, WeierstrassCurve<E> const &wc, C const &context, u8 extension_degree)
+{
+    std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> chunk;
+    chunk.reserve(std::min(num_pairs, MULTIEXP_STREAM_CHUNK));
+    if (num_pairs <= MULTIEXP_STREAM_CHUNK)
+    {
+        for (usize i = 0; i < num_pairs; i++)
+        {
+            chunk.push_back(next_pair());
+        }
+        return multiexp(chunk, wc, context, extension_degree);
+    }
+
+    // One plan for all chunks, so that their windows add up. Any scalars can go with a plan, a chunk that can not
+    // be split runs as it is with the plan for split chunks.
+    auto const scalar_bits = num_bits(wc.subgroup_order());
+    auto const split_chunks = endomorphism_split_pays(MULTIEXP_STREAM_CHUNK, scalar_bits, extension_degree, wc);
+    auto const plan = split_chunks ? pippenger_plan(2 * MULTIEXP_STREAM_CHUNK, endomorphism_split_bits(wc), extension_degree, wc)
+                                   : pippenger_plan(MULTIEXP_STREAM_CHUNK, scalar_bits, extension_degree, wc);
+    MultiexpCounters::getInstance().record_pippenger(plan.window, plan.batch_affine);
+
+    std::vector<CurvePoint<E>> sums;
+    std::vector<std::tuple<AffinePoint<E>, std::vector<u64>>> split;
+    bool was_split = false;
+    for (usize read = 0; read < num_pairs;)
+    {
+        chunk.clear();
+        for (; read < num_pairs && chunk.size() < MULTIEXP_STREAM_CHUNK; read++)
+        {
+            chunk.push_back(next_pair());
+        }
+        if (split_chunks && endomorphism_split(chunk, wc, context, split))
+        {
+            was_split = true;
+            accumulate_pippenger(split, wc, context, plan, sums);
+        }
+        else
+        {
+            accumulate_pippenger(chunk, wc, context, plan, sums);
+        }
+    }
+    if (was_split)
+    {
+        MultiexpCounters::getInstance().record_endomorphism();
+    }
+    return merge_pippenger_windows(sums, plan.window, wc, context);
+}
+
 #endif
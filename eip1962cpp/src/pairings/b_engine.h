@@ -7,11 +7,15 @@
 #include "../extension_towers/fp2.h"
 #include "../extension_towers/fp6_3.h"
 #include "../extension_towers/fp12.h"
+#include "line_cache.h"
+#include "parallel.h"
 
 template <usize N>
 using ThreePoint = std::tuple<Fp2<N>, Fp2<N>, Fp2<N>>;
 
-template <usize N>
+// Common part of BN and BLS12 engines. ENGINE is the engine deriving from it and provides miller_loop, prepare and
+// final_exponentiation, which are called statically so that they inline into the loops here.
+template <usize N, class ENGINE>
 class Bengine
 {
 protected:
@@ -19,30 +23,67 @@ protected:
     bool u_is_negative;
     TwistType twist_type;
     WeierstrassCurve<Fp2<N>> const &curve_twist;
+    // Encoded pairing parameters, prepared lines are cached under it. Empty if lines are not cached.
+    std::string line_cache_key;
 
 public:
     Bengine(std::vector<u64> u,
             bool u_is_negative,
             TwistType twist_type,
-            WeierstrassCurve<Fp2<N>> const &curve_twist) : u(u), u_is_negative(u_is_negative), twist_type(twist_type), curve_twist(curve_twist) {}
+            WeierstrassCurve<Fp2<N>> const &curve_twist,
+            std::string line_cache_key = "") : u(u), u_is_negative(u_is_negative), twist_type(twist_type), curve_twist(curve_twist), line_cache_key(line_cache_key) {}
 
     std::optional<Fp12<N>>
-    pair(std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const
+    pair(std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const
     {
         if (points.size() == 0)
         {
             return {};
         }
-        auto res = miller_loop(points, context);
-        return final_exponentiation(res);
+        return engine().final_exponentiation(miller_value(points, context));
+    }
+
+    // Product of the Miller loops of all pairs, before the final exponentiation
+    Fp12<N> miller_value(std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const
+    {
+        auto const res = partitioned_miller_loop<Fp12<N>>(points, [&](std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<Fp2<N>>>> const &part) {
+            return std::optional<Fp12<N>>(engine().miller_loop(part, context));
+        });
+        return res.value();
+    }
+
+    std::optional<Fp12<N>> final_exponentiate(Fp12<N> const &f) const
+    {
+        return engine().final_exponentiation(f);
     }
 
 protected:
-    virtual Fp12<N> miller_loop(std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const = 0;
+    ENGINE const &engine() const
+    {
+        return static_cast<ENGINE const &>(*this);
+    }
 
-    virtual std::vector<ThreePoint<N>> prepare(CurvePoint<Fp2<N>> const &twist_point, FieldExtension2over3over2<N> const &context, Fp<N> const &two_inv) const = 0;
+    // Line coefficients of the point, taken from the line cache if it was prepared before with the same parameters
+    std::vector<ThreePoint<N>> prepare_cached(AffinePoint<Fp2<N>> const &twist_point, FieldExtension2over3over2<N> const &context, Fp<N> const &two_inv) const
+    {
+        auto &cache = LineCache::getInstance();
+        if (line_cache_key.empty() || cache.lines.capacity() == 0)
+        {
+            return engine().prepare(twist_point, context, two_inv);
+        }
+
+        auto const key = PreparedLines::key(line_cache_key, twist_point);
+        if (auto const lines = cache.lines.get(key))
+        {
+            return lines->template load<N>(context);
+        }
 
-    virtual std::optional<Fp12<N>> final_exponentiation(Fp12<N> const &f) const = 0;
+        auto coeffs = engine().prepare(twist_point, context, two_inv);
+        auto const lines = PreparedLines::store(coeffs);
+        cache.lines.put(key, lines, key.size() + lines->bytes());
+
+        return coeffs;
+    }
 
     ThreePoint<N> doubling_step(
         CurvePoint<Fp2<N>> &r,
@@ -146,9 +187,8 @@ protected:
 
     ThreePoint<N> addition_step(
         CurvePoint<Fp2<N>> &r,
-        CurvePoint<Fp2<N>> const &q) const
+        AffinePoint<Fp2<N>> const &q) const
     {
-        assert(q.is_normalized());
         // use adapted zexe formulas too instead of ones from pairing crate
         // Capitals are coors of R (homogenious), normals are coordinates of Q (affine)
         // Y - y*Z
@@ -228,12 +268,12 @@ protected:
         unreachable("");
     }
 
-    void for_ell(Fp12<N> &f, usize n, std::vector<CurvePoint<Fp<N>>> const &g1_references, std::vector<std::vector<ThreePoint<N>>> const &prepared_coeffs, std::vector<usize> &pc_indexes) const
+    void for_ell(Fp12<N> &f, usize n, std::vector<AffinePoint<Fp<N>>> const &g1_references, std::vector<std::vector<ThreePoint<N>>> const &prepared_coeffs, std::vector<usize> &pc_indexes) const
     {
         for (usize j = 0; j < n; j++)
         {
-            auto const p = g1_references[j];
-            auto const coeffs = prepared_coeffs[j][pc_indexes[j]];
+            auto const &p = g1_references[j];
+            auto const &coeffs = prepared_coeffs[j][pc_indexes[j]];
             pc_indexes[j]++;
             ell(f, coeffs, p);
         }
@@ -242,9 +282,8 @@ protected:
     void ell(
         Fp12<N> &f,
         ThreePoint<N> const &coeffs,
-        CurvePoint<Fp<N>> const &p) const
+        AffinePoint<Fp<N>> const &p) const
     {
-        assert(p.is_normalized());
         auto c0 = std::get<0>(coeffs);
         auto c1 = std::get<1>(coeffs);
         auto c2 = std::get<2>(coeffs);
@@ -0,0 +1,152 @@
+#ifndef H_PAIRING_BATCH
+#define H_PAIRING_BATCH
+
+#include <random>
+
+#include "../common.h"
+#include "../constants.h"
+#include "../cache.h"
+#include "../fp.h"
+
+/*
+Batched verification of BN and BLS12 pairing checks with one final exponentiation.
+
+Every pairing check is FE(M_i) == 1 for the product M_i of its Miller loops. The final exponentiation FE is a power map,
+so FE(prod M_i^w_i) = prod FE(M_i)^w_i. For curves whose modulus p and group order r are the polynomials of the loop
+parameter u, FE maps into the group of r-th roots of unity, and for a prime r a random nonzero w_j below r makes the
+product 1 with probability 1/(r - 1) at most if FE(M_j) != 1, whatever the other factors. So one final exponentiation
+of the weighted product verifies all checks of a batch at once with weights of 64 bits. The powers share their
+squarings, so a batch costs 64 squarings and about 32 multiplications per check on top of the Miller loops.
+
+Weights go on the Miller values instead of the G1 points, since inputs may skip the subgroup checks and points
+outside of the subgroup of order r would not scale the pairing by the weight.
+
+If the product is not 1, or a check of the batch can not be decoded, the checks run one by one as before, so results
+and errors are the same as those of run.
+*/
+
+// Verdicts of the other inputs of a batch
+static const u8 BATCH_RUN_ALONE = 0;
+static const u8 BATCH_VERIFIED = 1;
+static const u8 BATCH_OTHER_CURVE = 2;
+
+// Inputs batched with the one that is decoded. Members with other parameters keep BATCH_OTHER_CURVE.
+struct PairingBatch
+{
+    std::vector<std::vector<std::uint8_t>> const &inputs;
+    // Indexes of the other inputs
+    std::vector<usize> members;
+    std::vector<u8> verdicts;
+};
+
+// Random nonzero weight of 64 bits
+u64 inline batch_weight(std::random_device &random)
+{
+    u64 w = 0;
+    while (w == 0)
+    {
+        w = (u64(random()) << 32) | u64(random());
+    }
+    return w;
+}
+
+// values[0]^weights[0] * ... * values[n - 1]^weights[n - 1], where all powers share the squarings of one accumulator
+template <class E>
+E weighted_product(std::vector<E> const &values, std::vector<u64> const &weights, E const &one)
+{
+    auto res = one;
+    for (usize bit = 64; bit-- > 0;)
+    {
+        res.square();
+        for (usize i = 0; i < values.size(); i++)
+        {
+            if ((weights[i] >> bit) & 1)
+            {
+                res.mul(values[i]);
+            }
+        }
+    }
+    return res;
+}
+
+// Miller-Rabin test of an odd n above 2^64 with random bases below 2^64
+template <usize N>
+bool is_probable_prime(Repr<N> const &n, usize rounds)
+{
+    constexpr Repr<N> one = {1};
+    if (is_even(n) || cbn::detail::bit_length(n) <= 64 || cbn::detail::bit_length(n) + 1 > N * LIMB_BITS)
+    {
+        return false;
+    }
+
+    auto const field = PrimeField<N>(n);
+    auto const n_minus_one = cbn::subtract_ignore_carry(n, one);
+    auto d = n_minus_one;
+    usize s = 0;
+    while (is_even(d))
+    {
+        d = cbn::shift_right(d, 1);
+        s++;
+    }
+
+    auto const unit = Fp<N>::one(field);
+    auto minus_unit = unit;
+    minus_unit.negate();
+
+    std::random_device random;
+    for (usize round = 0; round < rounds; round++)
+    {
+        Repr<N> a = {0};
+        a[0] = batch_weight(random) | 2;
+        auto x = Fp<N>::from_repr(a, field).pow(d);
+        if (x == unit || x == minus_unit)
+        {
+            continue;
+        }
+        auto witness = true;
+        for (usize i = 1; i < s && witness; i++)
+        {
+            x.square();
+            witness = x != minus_unit;
+        }
+        if (witness)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Process wide record of the pairing parameters that were checked for batching
+class PairingBatchCurves
+{
+public:
+    static PairingBatchCurves &getInstance()
+    {
+        static PairingBatchCurves instance;
+        return instance;
+    }
+
+    // Whether checks with the parameters can be batched, check runs once per parameters key
+    template <class F>
+    bool batchable(std::string const &key, F &&check)
+    {
+        if (auto const known = curves.get(key))
+        {
+            return *known;
+        }
+        auto const res = check();
+        curves.put(key, std::make_shared<bool const>(res), key.size() + sizeof(bool));
+        return res;
+    }
+
+private:
+    LruCache<bool> curves;
+
+    PairingBatchCurves() : curves(PAIRING_BATCH_CURVES_MAX_BYTES) {}
+    ~PairingBatchCurves() = default;
+    PairingBatchCurves(const PairingBatchCurves &) = delete;
+    PairingBatchCurves &operator=(const PairingBatchCurves &) = delete;
+};
+
+#endif
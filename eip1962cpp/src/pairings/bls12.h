@@ -5,14 +5,16 @@
 #include "../constants.h"
 
 template <usize N>
-class BLS12engine : public Bengine<N>
+class BLS12engine : public Bengine<N, BLS12engine<N>>
 {
+    friend class Bengine<N, BLS12engine<N>>;
 
 public:
     BLS12engine(std::vector<u64> u,
                 bool u_is_negative,
                 TwistType twist_type,
-                WeierstrassCurve<Fp2<N>> const &curve_twist, Fp2<N> const &non_residue) : Bengine<N>(u, u_is_negative, twist_type, curve_twist)
+                WeierstrassCurve<Fp2<N>> const &curve_twist, Fp2<N> const &non_residue,
+                std::string line_cache_key = "") : Bengine<N, BLS12engine<N>>(u, u_is_negative, twist_type, curve_twist, line_cache_key)
     {
         UNUSED(non_residue);
         if (calculate_hamming_weight(this->u) > MAX_BLS12_X_HAMMING)
@@ -21,10 +23,38 @@ public:
         }
     }
 
+    // True if r = u^4 - u^2 + 1 and 3(p - u) = (u - 1)^2 * r, the final exponentiation only maps into the r-th roots
+    // of unity for such parameters
+    static bool parameters_of_u(Repr<N> const &modulus, std::vector<u64> const &order, std::vector<u64> const &u, bool u_is_negative)
+    {
+        // (u - 1)^2 * r has to fit into N + 1 limbs
+        if (num_bits(u) * 6 > N * LIMB_BITS + 8)
+        {
+            return false;
+        }
+        constexpr usize M = N + 1;
+        auto const ou = repr_from_limbs<M>(u);
+        auto const oorder = repr_from_limbs<M>(order);
+        if (!ou || !oorder)
+        {
+            return false;
+        }
+        auto const c = [](u64 value) { return SignedRepr<M>{Repr<M>{value}, false}; };
+        auto const x = SignedRepr<M>{ou.value(), u_is_negative};
+        auto const x2 = signed_mul(x, x);
+        auto const x4 = signed_mul(x2, x2);
+
+        auto const r = signed_add(signed_sub(x4, x2), c(1));
+        auto const x_minus_one = signed_sub(x, c(1));
+        auto const rhs = signed_mul(signed_mul(x_minus_one, x_minus_one), r);
+        auto const lhs = signed_mul(c(3), signed_sub(SignedRepr<M>{cbn::detail::pad<1>(modulus), false}, x));
+        return !r.negative && r.magnitude == oorder.value() && lhs.negative == rhs.negative && lhs.magnitude == rhs.magnitude;
+    }
+
 protected:
-    Fp12<N> miller_loop(std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const
+    Fp12<N> miller_loop(std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const
     {
-        std::vector<CurvePoint<Fp<N>>> g1_references;
+        std::vector<AffinePoint<Fp<N>>> g1_references;
         std::vector<std::vector<ThreePoint<N>>> prepared_coeffs;
 
         auto two_inv_ = Fp<N>::one(context);
@@ -37,7 +67,7 @@ protected:
             auto const q = std::get<1>(*it);
             if (!p.is_zero() && !q.is_zero())
             {
-                auto coeffs = prepare(q, context, two_inv);
+                auto coeffs = this->prepare_cached(q, context, two_inv);
                 prepared_coeffs.push_back(coeffs);
                 g1_references.push_back(p);
             }
@@ -72,10 +102,8 @@ protected:
         return f;
     }
 
-    std::vector<ThreePoint<N>> prepare(CurvePoint<Fp2<N>> const &twist_point, FieldExtension2over3over2<N> const &context, Fp<N> const &two_inv) const
+    std::vector<ThreePoint<N>> prepare(AffinePoint<Fp2<N>> const &twist_point, FieldExtension2over3over2<N> const &context, Fp<N> const &two_inv) const
     {
-        assert(twist_point.is_normalized());
-
         std::vector<ThreePoint<N>> ell_coeffs;
 
         if (twist_point.is_zero())
@@ -83,7 +111,7 @@ protected:
             return ell_coeffs;
         }
 
-        auto r = CurvePoint<Fp2<N>>(twist_point.x, twist_point.y);
+        auto r = CurvePoint<Fp2<N>>(twist_point);
 
         auto it = RevBitIterator(this->u);
         it.before(); //skip 1
@@ -4,8 +4,10 @@
 #include "b_engine.h"
 
 template <usize N>
-class BNengine : public Bengine<N>
+class BNengine : public Bengine<N, BNengine<N>>
 {
+    friend class Bengine<N, BNengine<N>>;
+
     std::vector<u64> six_u_plus_2;
     Fp2<N> non_residue_in_p_minus_one_over_2;
 
@@ -14,7 +16,8 @@ public:
              bool u_is_negative,
              TwistType twist_type,
              WeierstrassCurve<Fp2<N>> const &curve_twist,
-             Fp2<N> const &non_residue) : Bengine<N>(u, u_is_negative, twist_type, curve_twist),
+             Fp2<N> const &non_residue,
+             std::string line_cache_key = "") : Bengine<N, BNengine<N>>(u, u_is_negative, twist_type, curve_twist, line_cache_key),
                                           non_residue_in_p_minus_one_over_2(non_residue)
     {
         // Calculate six_u_plus_two
@@ -37,11 +40,39 @@ public:
         non_residue_in_p_minus_one_over_2 = non_residue.pow(p_minus_one_over_2);
     }
 
+    // True if p = 36u^4 + 36u^3 + 24u^2 + 6u + 1 and r = 36u^4 + 36u^3 + 18u^2 + 6u + 1, the final exponentiation
+    // only maps into the r-th roots of unity for such parameters
+    static bool parameters_of_u(Repr<N> const &modulus, std::vector<u64> const &order, std::vector<u64> const &u, bool u_is_negative)
+    {
+        // 36u^4 has to fit into N + 1 limbs
+        if (num_bits(u) * 4 > N * LIMB_BITS)
+        {
+            return false;
+        }
+        constexpr usize M = N + 1;
+        auto const ou = repr_from_limbs<M>(u);
+        auto const oorder = repr_from_limbs<M>(order);
+        if (!ou || !oorder)
+        {
+            return false;
+        }
+        auto const c = [](u64 value) { return SignedRepr<M>{Repr<M>{value}, false}; };
+        auto const x = SignedRepr<M>{ou.value(), u_is_negative};
+        auto const x2 = signed_mul(x, x);
+        auto const x3 = signed_mul(x2, x);
+        auto const x4 = signed_mul(x3, x);
+
+        auto const common = signed_add(signed_add(signed_mul(c(36), x4), signed_mul(c(36), x3)), signed_add(signed_mul(c(6), x), c(1)));
+        auto const p = signed_add(common, signed_mul(c(24), x2));
+        auto const r = signed_add(common, signed_mul(c(18), x2));
+        return !p.negative && !r.negative && p.magnitude == cbn::detail::pad<1>(modulus) && r.magnitude == oorder.value();
+    }
+
 protected:
-    Fp12<N> miller_loop(std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const
+    Fp12<N> miller_loop(std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<Fp2<N>>>> const &points, FieldExtension2over3over2<N> const &context) const
     {
 
-        std::vector<CurvePoint<Fp<N>>> g1_references;
+        std::vector<AffinePoint<Fp<N>>> g1_references;
         std::vector<std::vector<ThreePoint<N>>> prepared_coeffs;
 
         auto two_inv_ = Fp<N>::one(context);
@@ -54,7 +85,7 @@ protected:
             auto const q = std::get<1>(*it);
             if (!p.is_zero() && !q.is_zero())
             {
-                auto coeffs = prepare(q, context, two_inv);
+                auto coeffs = this->prepare_cached(q, context, two_inv);
                 prepared_coeffs.push_back(coeffs);
                 g1_references.push_back(p);
             }
@@ -97,10 +128,8 @@ protected:
         return f;
     }
 
-    std::vector<ThreePoint<N>> prepare(CurvePoint<Fp2<N>> const &twist_point, FieldExtension2over3over2<N> const &context, Fp<N> const &two_inv) const
+    std::vector<ThreePoint<N>> prepare(AffinePoint<Fp2<N>> const &twist_point, FieldExtension2over3over2<N> const &context, Fp<N> const &two_inv) const
     {
-        assert(twist_point.is_normalized());
-
         std::vector<ThreePoint<N>> ell_coeffs;
 
         if (twist_point.is_zero())
@@ -108,7 +137,7 @@ protected:
             return ell_coeffs;
         }
 
-        auto r = CurvePoint<Fp2<N>>(twist_point.x, twist_point.y);
+        auto r = CurvePoint<Fp2<N>>(twist_point);
 
         auto it = RevBitIterator(six_u_plus_2);
         it.before(); //skip 1
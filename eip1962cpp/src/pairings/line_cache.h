@@ -0,0 +1,90 @@
+#ifndef H_LINE_CACHE
+#define H_LINE_CACHE
+
+#include "../common.h"
+#include "../constants.h"
+#include "../cache.h"
+#include "../curve.h"
+#include "../extension_towers/fp2.h"
+
+/*
+Prepared line coefficients of G2 points for BN and BLS12 pairings. Verifiers pair against the same verifying key points
+in almost every call, so the coefficients of a point are kept in a bounded LRU cache after it was prepared once.
+Keys are the encoded pairing parameters (curve, extensions, twist type, loop parameter and its sign) and the point.
+*/
+
+// Coefficients of one point, stored as limbs so that they do not depend on the field of the call that prepared them
+class PreparedLines
+{
+public:
+    usize const steps;
+    std::vector<u64> const limbs;
+
+    PreparedLines(usize steps, std::vector<u64> limbs) : steps(steps), limbs(limbs) {}
+
+    usize bytes() const
+    {
+        return limbs.size() * sizeof(u64) + sizeof(PreparedLines);
+    }
+
+    template <usize N>
+    static std::shared_ptr<PreparedLines const> store(std::vector<std::tuple<Fp2<N>, Fp2<N>, Fp2<N>>> const &coeffs)
+    {
+        constexpr auto element_limbs = ElementLimbs<Fp2<N>>::count;
+        std::vector<u64> limbs(coeffs.size() * 3 * element_limbs);
+        for (usize i = 0; i < coeffs.size(); i++)
+        {
+            auto const dst = limbs.data() + 3 * i * element_limbs;
+            ElementLimbs<Fp2<N>>::store(std::get<0>(coeffs[i]), dst);
+            ElementLimbs<Fp2<N>>::store(std::get<1>(coeffs[i]), dst + element_limbs);
+            ElementLimbs<Fp2<N>>::store(std::get<2>(coeffs[i]), dst + 2 * element_limbs);
+        }
+        return std::make_shared<PreparedLines const>(coeffs.size(), limbs);
+    }
+
+    template <usize N, class C>
+    std::vector<std::tuple<Fp2<N>, Fp2<N>, Fp2<N>>> load(C const &context) const
+    {
+        constexpr auto element_limbs = ElementLimbs<Fp2<N>>::count;
+        std::vector<std::tuple<Fp2<N>, Fp2<N>, Fp2<N>>> res;
+        res.reserve(steps);
+        for (usize i = 0; i < steps; i++)
+        {
+            auto const src = limbs.data() + 3 * i * element_limbs;
+            res.emplace_back(ElementLimbs<Fp2<N>>::load(src, context), ElementLimbs<Fp2<N>>::load(src + element_limbs, context), ElementLimbs<Fp2<N>>::load(src + 2 * element_limbs, context));
+        }
+        return res;
+    }
+
+    // Key of a point for the given parameters key
+    template <usize N>
+    static std::string key(std::string const &parameters, AffinePoint<Fp2<N>> const &point)
+    {
+        constexpr auto element_limbs = ElementLimbs<Fp2<N>>::count;
+        u64 limbs[2 * element_limbs];
+        ElementLimbs<Fp2<N>>::store(point.x, limbs);
+        ElementLimbs<Fp2<N>>::store(point.y, limbs + element_limbs);
+        return parameters + std::string(reinterpret_cast<char const *>(limbs), sizeof(limbs));
+    }
+};
+
+// Process wide cache of prepared lines
+class LineCache
+{
+public:
+    static LineCache &getInstance()
+    {
+        static LineCache instance;
+        return instance;
+    }
+
+    LruCache<PreparedLines> lines;
+
+private:
+    LineCache() : lines(LINE_CACHE_MAX_BYTES) {}
+    ~LineCache() = default;
+    LineCache(const LineCache &) = delete;
+    LineCache &operator=(const LineCache &) = delete;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "../fp.h"
 #include "../extension_towers/fp2.h"
 #include "../extension_towers/fp4.h"
+#include "parallel.h"
 
 template <class F, usize N>
 struct AteDoubleCoefficients
@@ -40,7 +41,9 @@ struct PrecomputedG2
     std::vector<AteAdditionCoefficients<F, N>> addition_coefficients;
 };
 
-template <class F1, class F2, usize N>
+// Common part of MNT4 and MNT6 engines. ENGINE is the engine deriving from it and provides
+// final_exponentiation_part_one, which is called statically.
+template <class F1, class F2, usize N, class ENGINE>
 class MNTengine
 {
     std::vector<u64> x;
@@ -58,14 +61,16 @@ public:
 
     template <class C>
     std::optional<F2>
-    pair(std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<F1>>> const &points, C const &context) const
+    pair(std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<F1>>> const &points, C const &context) const
     {
         if (points.size() == 0)
         {
             return {};
         }
 
-        auto ores = miller_loop(points, context);
+        auto ores = partitioned_miller_loop<F2>(points, [&](std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<F1>>> const &part) {
+            return miller_loop(part, context);
+        });
         if (!ores) {
             return {};
         }
@@ -76,46 +81,38 @@ public:
     }
 
 private:
+    // All pairs share one accumulator, so it is squared once per bit of x however many pairs there are
     template <class C>
-    std::optional<F2> miller_loop(std::vector<std::tuple<CurvePoint<Fp<N>>, CurvePoint<F1>>> const &points, C const &context) const
+    std::optional<F2> miller_loop(std::vector<std::tuple<AffinePoint<Fp<N>>, AffinePoint<F1>>> const &points, C const &context) const
     {
-        auto f = F2::one(context);
-        for (auto it = points.cbegin(); it != points.cend(); it++)
-        {
-            std::optional<F2> const ml_opt = ate_pairing_loop(std::get<0>(*it), std::get<1>(*it), context);
-            if (!ml_opt) {
-                return {};
-            }
-            auto const ml = ml_opt.value();
-            f.mul(ml);
-        }
-        return f;
-    }
-
-    template <class C>
-    std::optional<F2> ate_pairing_loop(
-        CurvePoint<Fp<N>> const &point,
-        CurvePoint<F1> const &twist_point, C const &context) const
-    {
-        assert(point.is_normalized());
-        assert(twist_point.is_normalized());
         auto const twist_inv_opt = this->twist.inverse();
         if (!twist_inv_opt) {
             return {};
         };
-        
+
         auto const twist_inv = twist_inv_opt.value();
 
-        auto const p = precompute_g1(point);
-        auto const oq = precompute_g2(twist_point, twist_inv, context);
-        if (!oq) {
-            return {};
+        std::vector<PrecomputedG1<F1, N>> g1_precomputations;
+        std::vector<PrecomputedG2<F1, N>> g2_precomputations;
+        std::vector<F1> l1_coeffs;
+        for (auto it = points.cbegin(); it != points.cend(); it++)
+        {
+            auto const p = precompute_g1(std::get<0>(*it));
+            auto oq = precompute_g2(std::get<1>(*it), twist_inv, context);
+            if (!oq) {
+                return {};
+            }
+
+            auto l1_coeff = F1::zero(context);
+            l1_coeff.c0 = p.x;
+            l1_coeff.sub(oq.value().x_over_twist);
+
+            g1_precomputations.push_back(p);
+            g2_precomputations.push_back(std::move(oq.value()));
+            l1_coeffs.push_back(l1_coeff);
         }
-        auto const q = oq.value();
-        auto l1_coeff = F1::zero(context);
-        l1_coeff.c0 = p.x;
-        l1_coeff.sub(q.x_over_twist);
 
+        auto const n = g1_precomputations.size();
         auto f = F2::one(context);
 
         usize dbl_idx = 0;
@@ -127,72 +124,30 @@ private:
         {
             auto const bit = *it;
 
-            auto const dc = q.double_coefficients[dbl_idx];
-            dbl_idx += 1;
-
-            auto g_rr_at_p = F2::zero(context);
-
-            auto t0 = dc.c_j;
-            t0.mul(p.x_by_twist);
-            t0.negate();
-            t0.add(dc.c_l);
-            t0.sub(dc.c_4c);
-
-            auto t1 = dc.c_h;
-            t1.mul(p.y_by_twist);
-
-            g_rr_at_p.c0 = t0;
-            g_rr_at_p.c1 = t1;
-
             f.square();
-            f.mul(g_rr_at_p);
+            for (usize j = 0; j < n; j++)
+            {
+                f.mul(doubling_line(g1_precomputations[j], g2_precomputations[j].double_coefficients[dbl_idx], context));
+            }
+            dbl_idx += 1;
 
             if (bit)
             {
-                auto const ac = q.addition_coefficients[add_idx];
+                for (usize j = 0; j < n; j++)
+                {
+                    f.mul(addition_line(g1_precomputations[j], g2_precomputations[j], l1_coeffs[j], g2_precomputations[j].addition_coefficients[add_idx], context));
+                }
                 add_idx += 1;
-
-                auto g_rq_at_p = F2::zero(context);
-
-                auto t0 = ac.c_rz;
-                t0.mul(p.y_by_twist);
-
-                auto t = l1_coeff;
-                t.mul(ac.c_l1);
-
-                auto t1 = q.y_over_twist;
-                t1.mul(ac.c_rz);
-                t1.add(t);
-                t1.negate();
-
-                g_rq_at_p.c0 = t0;
-                g_rq_at_p.c1 = t1;
-
-                f.mul(g_rq_at_p);
             }
         }
 
         if (this->x_is_negative)
         {
-            auto const ac = q.addition_coefficients[add_idx];
-
-            auto g_rnegr_at_p = F2::zero(context);
-
-            auto t0 = ac.c_rz;
-            t0.mul(p.y_by_twist);
-
-            auto t = l1_coeff;
-            t.mul(ac.c_l1);
-
-            auto t1 = q.y_over_twist;
-            t1.mul(ac.c_rz);
-            t1.add(t);
-            t1.negate();
-
-            g_rnegr_at_p.c0 = t0;
-            g_rnegr_at_p.c1 = t1;
-
-            f.mul(g_rnegr_at_p);
+            // Product of the inverses of all pairs is the inverse of the product
+            for (usize j = 0; j < n; j++)
+            {
+                f.mul(addition_line(g1_precomputations[j], g2_precomputations[j], l1_coeffs[j], g2_precomputations[j].addition_coefficients[add_idx], context));
+            }
             auto const of = f.inverse();
             if (!of) {
                 return {};
@@ -203,9 +158,52 @@ private:
         return f;
     }
 
-    PrecomputedG1<F1, N> precompute_g1(CurvePoint<Fp<N>> const &g1_point) const
+    // Doubling line at p
+    template <class C>
+    F2 doubling_line(PrecomputedG1<F1, N> const &p, AteDoubleCoefficients<F1, N> const &dc, C const &context) const
+    {
+        auto g_rr_at_p = F2::zero(context);
+
+        auto t0 = dc.c_j;
+        t0.mul(p.x_by_twist);
+        t0.negate();
+        t0.add(dc.c_l);
+        t0.sub(dc.c_4c);
+
+        auto t1 = dc.c_h;
+        t1.mul(p.y_by_twist);
+
+        g_rr_at_p.c0 = t0;
+        g_rr_at_p.c1 = t1;
+
+        return g_rr_at_p;
+    }
+
+    // Addition line at p
+    template <class C>
+    F2 addition_line(PrecomputedG1<F1, N> const &p, PrecomputedG2<F1, N> const &q, F1 const &l1_coeff, AteAdditionCoefficients<F1, N> const &ac, C const &context) const
+    {
+        auto g_rq_at_p = F2::zero(context);
+
+        auto t0 = ac.c_rz;
+        t0.mul(p.y_by_twist);
+
+        auto t = l1_coeff;
+        t.mul(ac.c_l1);
+
+        auto t1 = q.y_over_twist;
+        t1.mul(ac.c_rz);
+        t1.add(t);
+        t1.negate();
+
+        g_rq_at_p.c0 = t0;
+        g_rq_at_p.c1 = t1;
+
+        return g_rq_at_p;
+    }
+
+    PrecomputedG1<F1, N> precompute_g1(AffinePoint<Fp<N>> const &g1_point) const
     {
-        // not asserting normalization, it will be asserted in the loop
         auto x_twist = this->twist;
         x_twist.mul_by_fp(g1_point.x);
 
@@ -221,9 +219,8 @@ private:
     }
 
     template <class C>
-    std::optional<PrecomputedG2<F1, N>> precompute_g2(CurvePoint<F1> const &g2_point, F1 const &twist_inv, C const &context) const
+    std::optional<PrecomputedG2<F1, N>> precompute_g2(AffinePoint<F1> const &g2_point, F1 const &twist_inv, C const &context) const
     {
-        // not asserting normalization, it will be asserted in the loop
         // precompute addition and doubling coefficients
         auto x_over_twist = g2_point.x;
         x_over_twist.mul(twist_inv);
@@ -455,14 +452,13 @@ private:
             return {};
         }
         auto const value_inv = ovalue_inv.value();
-        auto const value_to_first_chunk = this->final_exponentiation_part_one(f, value_inv);
-        auto const value_inv_to_first_chunk = this->final_exponentiation_part_one(value_inv, f);
+        auto const &engine = static_cast<ENGINE const &>(*this);
+        auto const value_to_first_chunk = engine.final_exponentiation_part_one(f, value_inv);
+        auto const value_inv_to_first_chunk = engine.final_exponentiation_part_one(value_inv, f);
 
         return this->final_exponentiation_part_two(value_to_first_chunk, value_inv_to_first_chunk);
     }
 
-    virtual F2 final_exponentiation_part_one(F2 const &elt, F2 const &elt_inv) const = 0;
-
     F2 final_exponentiation_part_two(F2 const &elt, F2 const &elt_inv) const
     {
         auto elt_q = elt;
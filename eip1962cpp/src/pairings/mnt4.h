@@ -9,11 +9,11 @@
 #include "mnt.h"
 
 template <usize N>
-class MNT4engine : public MNTengine<Fp2<N>, Fp4<N>, N>
+class MNT4engine : public MNTengine<Fp2<N>, Fp4<N>, N, MNT4engine<N>>
 {
 public:
     MNT4engine(std::vector<u64> x, bool x_is_negative, std::vector<u64> exp_w0, std::vector<u64> exp_w1, bool exp_w0_is_negative,
-               WeierstrassCurve<Fp2<N>> const &curve_twist, Fp2<N> twist) : MNTengine<Fp2<N>, Fp4<N>, N>(x, x_is_negative, exp_w0, exp_w1, exp_w0_is_negative, curve_twist, twist)
+               WeierstrassCurve<Fp2<N>> const &curve_twist, Fp2<N> twist) : MNTengine<Fp2<N>, Fp4<N>, N, MNT4engine<N>>(x, x_is_negative, exp_w0, exp_w1, exp_w0_is_negative, curve_twist, twist)
     {
     }
 
@@ -9,11 +9,11 @@
 #include "mnt.h"
 
 template <usize N>
-class MNT6engine : public MNTengine<Fp3<N>, Fp6_2<N>, N>
+class MNT6engine : public MNTengine<Fp3<N>, Fp6_2<N>, N, MNT6engine<N>>
 {
 public:
     MNT6engine(std::vector<u64> x, bool x_is_negative, std::vector<u64> exp_w0, std::vector<u64> exp_w1, bool exp_w0_is_negative,
-               WeierstrassCurve<Fp3<N>> const &curve_twist, Fp3<N> twist) : MNTengine<Fp3<N>, Fp6_2<N>, N>(x, x_is_negative, exp_w0, exp_w1, exp_w0_is_negative, curve_twist, twist)
+               WeierstrassCurve<Fp3<N>> const &curve_twist, Fp3<N> twist) : MNTengine<Fp3<N>, Fp6_2<N>, N, MNT6engine<N>>(x, x_is_negative, exp_w0, exp_w1, exp_w0_is_negative, curve_twist, twist)
     {
     }
 
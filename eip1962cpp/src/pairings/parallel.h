@@ -0,0 +1,76 @@
+#ifndef H_PAIRING_PARALLEL
+#define H_PAIRING_PARALLEL
+
+#include <atomic>
+
+#include "../common.h"
+#include "../constants.h"
+#include "../thread_pool.h"
+
+/*
+Miller loops of many pairs over the threads of ThreadPool. The Miller loop of a set of pairs is the product of the
+Miller loops of the parts of any partition of it, and field arithmetic is exact, so pairs are split into consecutive
+parts, every part runs its own loop and the parts are multiplied in order. The result is the same as a single loop.
+*/
+
+class PairingSettings
+{
+public:
+    static PairingSettings &getInstance()
+    {
+        static PairingSettings instance;
+        return instance;
+    }
+
+    std::atomic<bool> parallel;
+
+private:
+    PairingSettings() : parallel(false) {}
+    ~PairingSettings() = default;
+    PairingSettings(const PairingSettings &) = delete;
+    PairingSettings &operator=(const PairingSettings &) = delete;
+};
+
+// Number of parts the pairs are split into, one per thread with at least PAIRING_PARALLEL_MIN_PAIRS pairs each
+usize inline pairing_parts(usize pairs)
+{
+    if (!PairingSettings::getInstance().parallel)
+    {
+        return 1;
+    }
+    auto const parts = std::min(ThreadPool::getInstance().threads(), pairs / PAIRING_PARALLEL_MIN_PAIRS);
+    return std::max(parts, usize(1));
+}
+
+// E: Element, P: pair
+// Product of miller_loop over the parts of the pairs. miller_loop returns std::optional<E>, the product is empty
+// if any part is empty.
+template <class E, class P, class L>
+std::optional<E> partitioned_miller_loop(std::vector<P> const &points, L const &miller_loop)
+{
+    auto const parts = pairing_parts(points.size());
+    if (parts == 1)
+    {
+        return miller_loop(points);
+    }
+
+    std::vector<std::optional<E>> results(parts);
+    ThreadPool::getInstance().run(parts, [&](usize part) {
+        auto const begin = points.cbegin() + points.size() * part / parts;
+        auto const end = points.cbegin() + points.size() * (part + 1) / parts;
+        results[part] = miller_loop(std::vector<P>(begin, end));
+    });
+
+    auto f = results[0];
+    for (usize part = 1; part < parts && f; part++)
+    {
+        if (!results[part])
+        {
+            return {};
+        }
+        f.value().mul(results[part].value());
+    }
+    return f;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef H_PIPPENGER_COSTS
+#define H_PIPPENGER_COSTS
+
+#include "common.h"
+
+// Costs relative to a Jacobian mixed addition
+struct PointCosts
+{
+    // Jacobian addition and doubling
+    double add;
+    double mul2;
+    // Affine addition in a batch, without the inversion
+    double batch_add;
+    double inverse;
+};
+
+struct PointCostsRow
+{
+    usize limbs;
+    bool a_is_zero;
+    // Indexed by extension degree - 1
+    PointCosts costs[3];
+};
+
+// Generated by `make bench FILTER=pippenger_costs`, rerun it when field or curve arithmetic changes.
+static const PointCostsRow PIPPENGER_COSTS[] = {
+    { 4, 1, {{1.86, 0.87, 0.60, 16.1}, {1.29, 0.68, 0.42, 2.6}, {1.42, 0.62, 0.61, 1.3}}},
+    { 4, 0, {{1.30, 0.92, 0.48, 10.8}, {1.17, 0.80, 0.58, 2.6}, {1.14, 0.85, 0.50, 1.5}}},
+    { 5, 1, {{1.22, 0.74, 0.54, 15.8}, {1.34, 0.67, 0.61, 3.4}, {1.33, 0.60, 0.61, 1.7}}},
+    { 5, 0, {{1.27, 0.91, 0.51, 13.9}, {1.37, 0.91, 0.53, 3.3}, {1.52, 0.92, 0.63, 1.8}}},
+    { 6, 1, {{1.35, 0.74, 0.53, 15.9}, {1.39, 0.67, 0.55, 3.8}, {1.42, 0.64, 0.60, 1.9}}},
+    { 6, 0, {{1.28, 0.97, 0.53, 16.0}, {1.39, 0.95, 0.56, 3.9}, {1.43, 0.91, 0.61, 2.0}}},
+    { 7, 1, {{1.39, 0.69, 0.55, 16.4}, {1.18, 0.57, 0.48, 3.1}, {1.47, 0.60, 0.58, 1.8}}},
+    { 7, 0, {{1.33, 0.91, 0.49, 15.1}, {1.40, 0.96, 0.55, 3.4}, {1.44, 0.82, 0.60, 1.8}}},
+    { 8, 1, {{1.31, 0.68, 0.50, 21.2}, {1.25, 0.63, 0.49, 4.9}, {1.42, 0.63, 0.56, 2.6}}},
+    { 8, 0, {{1.32, 0.98, 0.49, 21.7}, {1.33, 0.91, 0.53, 5.0}, {1.28, 0.73, 0.56, 2.6}}},
+    { 9, 1, {{1.36, 0.68, 0.52, 16.6}, {1.41, 0.67, 0.56, 4.1}, {1.44, 0.64, 0.59, 2.2}}},
+    { 9, 0, {{1.46, 0.99, 0.52, 16.2}, {1.39, 0.92, 0.55, 4.1}, {1.42, 0.87, 0.59, 2.1}}},
+    {10, 1, {{1.35, 0.69, 0.51, 20.1}, {1.38, 0.52, 0.54, 5.2}, {1.42, 0.64, 0.57, 2.6}}},
+    {10, 0, {{1.32, 0.92, 0.51, 20.3}, {1.44, 0.94, 0.56, 5.3}, {1.43, 0.89, 0.57, 2.7}}},
+    {11, 1, {{1.26, 0.68, 0.50, 18.4}, {1.57, 0.79, 0.66, 4.7}, {1.39, 0.63, 0.56, 2.3}}},
+    {11, 0, {{1.36, 0.91, 0.51, 19.0}, {1.37, 0.94, 0.54, 4.2}, {1.40, 0.87, 0.56, 2.3}}},
+    {12, 1, {{1.36, 0.66, 0.52, 19.3}, {1.41, 0.65, 0.55, 4.8}, {1.41, 0.60, 0.55, 2.4}}},
+    {12, 0, {{1.36, 0.92, 0.51, 18.8}, {1.39, 0.92, 0.54, 4.8}, {1.42, 0.88, 0.55, 2.4}}},
+    {13, 1, {{1.37, 0.67, 0.51, 18.7}, {1.40, 0.66, 0.54, 4.8}, {1.43, 0.63, 0.56, 2.4}}},
+    {13, 0, {{1.35, 0.89, 0.52, 18.2}, {1.39, 0.93, 0.54, 4.7}, {1.43, 0.88, 0.51, 2.4}}},
+    {14, 1, {{1.38, 0.66, 0.52, 24.2}, {1.82, 0.87, 0.68, 8.3}, {1.12, 0.56, 0.56, 3.4}}},
+    {14, 0, {{1.35, 0.91, 0.51, 25.8}, {1.01, 0.90, 0.55, 6.6}, {1.44, 0.87, 0.58, 3.4}}},
+    {15, 1, {{1.38, 0.66, 0.53, 19.2}, {1.35, 0.62, 0.52, 5.2}, {1.42, 0.62, 0.56, 2.5}}},
+    {15, 0, {{1.39, 0.94, 0.52, 19.1}, {1.42, 0.92, 0.56, 4.9}, {1.43, 0.87, 0.57, 2.4}}},
+    {16, 1, {{1.36, 0.65, 0.51, 24.6}, {1.44, 0.66, 0.55, 6.2}, {1.41, 0.62, 0.56, 3.1}}},
+    {16, 0, {{1.38, 0.92, 0.51, 24.5}, {1.43, 0.94, 0.54, 6.2}, {1.46, 0.88, 0.57, 3.1}}},
+};
+
+PointCosts inline pippenger_point_costs(usize limbs, u8 extension_degree, bool a_is_zero)
+{
+    for (auto const &row : PIPPENGER_COSTS)
+    {
+        if (row.limbs == limbs && row.a_is_zero == a_is_zero)
+        {
+            return row.costs[extension_degree - 1];
+        }
+    }
+    return PointCosts{1.4, 0.8, 0.6, 10};
+}
+
+#endif
@@ -386,6 +386,44 @@ std::vector<i64> into_wnaf(std::vector<u64> const &repr, usize window)
     return res;
 }
 
+usize into_signed_digits(std::vector<u64> const &repr, usize window, i32 *out, usize stride)
+{
+    assert(window > 0 && window < 32);
+
+    auto const bits = num_bits(repr);
+    const i32 max = i32(1) << window;
+    const i32 midpoint = i32(1) << (window - 1);
+    const u64 mask = (u64(1) << window) - 1;
+
+    usize count = 0;
+    i32 carry = 0;
+    for (usize bit = 0; bit < bits; bit += window)
+    {
+        auto const limb = bit / 64;
+        auto const shift = bit % 64;
+        u64 digit = repr[limb] >> shift;
+        if (shift + window > 64 && limb + 1 < repr.size())
+        {
+            digit |= repr[limb + 1] << (64 - shift);
+        }
+
+        i32 z = i32(digit & mask) + carry;
+        carry = 0;
+        if (z > midpoint)
+        {
+            z -= max;
+            carry = 1;
+        }
+        out[count++ * stride] = z;
+    }
+    if (carry != 0)
+    {
+        out[count++ * stride] = carry;
+    }
+
+    return count;
+}
+
 u32 calculate_hamming_weight(std::vector<u64> const &repr)
 {
     auto weight = 0;
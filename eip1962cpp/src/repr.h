@@ -39,6 +39,61 @@ bool is_zero(Repr<N> const &repr)
 
 } // namespace cbn
 
+// *********************** SIGNED Repr ******************* //
+
+// Integer of N limbs with a separate sign. Callers keep all values below 2^(64N).
+template <usize N>
+struct SignedRepr
+{
+    Repr<N> magnitude;
+    bool negative;
+};
+
+template <usize N>
+SignedRepr<N> signed_add(SignedRepr<N> const &a, SignedRepr<N> const &b)
+{
+    if (a.negative == b.negative)
+    {
+        return SignedRepr<N>{cbn::add_ignore_carry(a.magnitude, b.magnitude), a.negative};
+    }
+    if (a.magnitude < b.magnitude)
+    {
+        return SignedRepr<N>{cbn::subtract_ignore_carry(b.magnitude, a.magnitude), b.negative};
+    }
+    return SignedRepr<N>{cbn::subtract_ignore_carry(a.magnitude, b.magnitude), a.negative};
+}
+
+template <usize N>
+SignedRepr<N> signed_sub(SignedRepr<N> const &a, SignedRepr<N> const &b)
+{
+    return signed_add(a, SignedRepr<N>{b.magnitude, !b.negative});
+}
+
+template <usize N>
+SignedRepr<N> signed_mul(SignedRepr<N> const &a, SignedRepr<N> const &b)
+{
+    return SignedRepr<N>{cbn::partial_mul<N>(a.magnitude, b.magnitude), a.negative != b.negative};
+}
+
+// Value of little endian limbs if it fits into N limbs
+template <usize N>
+Option<Repr<N>> repr_from_limbs(std::vector<u64> const &limbs)
+{
+    Repr<N> res = {0};
+    for (usize i = 0; i < limbs.size(); i++)
+    {
+        if (i < N)
+        {
+            res[i] = limbs[i];
+        }
+        else if (limbs[i] != 0)
+        {
+            return {};
+        }
+    }
+    return res;
+}
+
 // *********************** FUNCTIONS on u64 ******************* //
 
 // Calculate a - b - borrow, returning the result and modifying
@@ -88,6 +143,10 @@ std::vector<i8> into_ternary_wnaf(std::vector<u64> const &repr);
 
 std::vector<i64> into_wnaf(std::vector<u64> const &repr, usize window);
 
+// Base 2^window digits in [-2^(window-1) + 1, 2^(window-1)], least significant first, written to out[0], out[stride], ...
+// There are at most ceil(bits / window) + 1 digits, returns how many were written.
+usize into_signed_digits(std::vector<u64> const &repr, usize window, i32 *out, usize stride);
+
 u32 calculate_hamming_weight(std::vector<u64> const &repr);
 
 // ********************** ITERATORS ******************* //
@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <cstdarg>
 #include <alloca.h>
+#include <fstream>
 
 #include "api.h"
 
@@ -46,9 +47,11 @@ std::string string_hex(std::vector<std::uint8_t> const &input)
     return s;
 }
 
-void api_test(std::vector<std::uint8_t> const &input, std::optional<std::vector<std::uint8_t>> const &output, std::string const &name)
+typedef std::variant<std::vector<std::uint8_t>, std::basic_string<char>> (*api_function)(std::vector<std::uint8_t> const &);
+
+void api_test(std::vector<std::uint8_t> const &input, std::optional<std::vector<std::uint8_t>> const &output, std::string const &name, api_function runner = run)
 {
-    auto const result = run(input);
+    auto const result = runner(input);
     if (auto answer = std::get_if<0>(&result))
     {
         if (output)
@@ -136,6 +139,38 @@ std::vector<std::uint8_t> parse_hex(std::string const &input)
     return data;
 }
 
+// Runs test vectors from a file with lines formatted as `name|input|output` in hex.
+// Empty output means that the call is expected to fail. Lines starting with # are skipped.
+void file_tests(std::string const &path, api_function runner = run)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cout << "Err: Can not open test vectors file: " << path << std::endl;
+        return;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        auto const first = line.find('|');
+        auto const second = line.find('|', first + 1);
+        auto const name = line.substr(0, first);
+        auto const input = parse_hex(line.substr(first + 1, second - first - 1));
+        auto const output_hex = line.substr(second + 1);
+        std::optional<std::vector<std::uint8_t>> output;
+        if (!output_hex.empty())
+        {
+            output = parse_hex(output_hex);
+        }
+        api_test(input, output, name, runner);
+    }
+}
+
 void tests()
 {
     {
@@ -165,6 +200,221 @@ void tests()
     // }
 }
 
+// Position of the number of pairs in a G1 or G2 multiexp input, and the lengths of its points and scalars
+struct MultiexpLayout
+{
+    std::size_t count_pos;
+    std::size_t point_len;
+    std::size_t order_len;
+};
+
+MultiexpLayout multiexp_layout(std::vector<std::uint8_t> const &input)
+{
+    // operation, modulus length, modulus, [extension degree, non-residue], a, b, order length, order, number of pairs
+    std::size_t const mod_len = input[1];
+    std::size_t pos = 2 + mod_len;
+    std::size_t ext = 1;
+    if (input[0] != 0x03)
+    {
+        ext = input[pos];
+        pos += 1 + mod_len;
+    }
+    pos += 2 * ext * mod_len;
+    std::size_t const order_len = input[pos];
+    pos += 1 + order_len;
+    return MultiexpLayout{pos, 2 * ext * mod_len, order_len};
+}
+
+// Every multiexp vector of a file again through run_large_multiexp, with the number of pairs in 4 bytes
+void large_multiexp_tests(std::string const &path)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto const first = line.find('|');
+        auto const second = line.find('|', first + 1);
+        auto const name = line.substr(0, first);
+        auto const output_hex = line.substr(second + 1);
+        if (line.empty() || line[0] == '#' || name.find("multiexp") == std::string::npos || output_hex.empty())
+        {
+            continue;
+        }
+        auto const input = parse_hex(line.substr(first + 1, second - first - 1));
+        auto const pos = multiexp_layout(input).count_pos;
+
+        std::vector<std::uint8_t> large(input.cbegin(), input.cbegin() + pos);
+        large.insert(large.end(), {0, 0, 0, input[pos]});
+        large.insert(large.end(), input.cbegin() + pos + 1, input.cend());
+        api_test(large, parse_hex(output_hex), "large " + name, run_large_multiexp);
+    }
+}
+
+// Splits every multiexp vector of a file into its points and scalars, registers the points as a base set
+// and checks the multiexp over the set against the expected output
+void multiexp_bases_tests(std::string const &path)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto const first = line.find('|');
+        auto const second = line.find('|', first + 1);
+        auto const name = line.substr(0, first);
+        auto const output_hex = line.substr(second + 1);
+        if (line.empty() || line[0] == '#' || name.find("multiexp") == std::string::npos || output_hex.empty())
+        {
+            continue;
+        }
+        auto const input = parse_hex(line.substr(first + 1, second - first - 1));
+
+        auto const layout = multiexp_layout(input);
+        auto const pos = layout.count_pos;
+        auto const point_len = layout.point_len;
+        auto const order_len = layout.order_len;
+
+        std::vector<std::uint8_t> bases(input.cbegin(), input.cbegin() + pos + 1);
+        std::vector<std::uint8_t> scalars;
+        for (std::size_t i = 0; i < input[pos]; i++)
+        {
+            auto const pair = input.cbegin() + pos + 1 + i * (point_len + order_len);
+            bases.insert(bases.end(), pair, pair + point_len);
+            scalars.insert(scalars.end(), pair + point_len, pair + point_len + order_len);
+        }
+
+        auto const handle = register_multiexp_bases(bases);
+        if (auto const err = std::get_if<1>(&handle))
+        {
+            std::cout << "Err: Base set registration errored (" << *err << "): " << name << std::endl;
+            continue;
+        }
+        auto const result = multiexp_with_bases(std::get<0>(handle), scalars);
+        release_multiexp_bases(std::get<0>(handle));
+        auto const released = multiexp_with_bases(std::get<0>(handle), scalars);
+
+        auto const answer = std::get_if<0>(&result);
+        if (answer && *answer == parse_hex(output_hex) && std::get_if<1>(&released))
+        {
+            std::cout << "Ok: base set " << name << std::endl;
+        }
+        else
+        {
+            std::cout << "Err: base set " << name << std::endl;
+        }
+    }
+}
+
+// Both multiexp algorithms must have run on the vectors, prints the Pippenger windows that were chosen
+void multiexp_stats_test()
+{
+    auto const stats = multiexp_stats();
+    std::string windows;
+    for (std::size_t window = 0; window < stats.pippenger_windows.size(); window++)
+    {
+        if (stats.pippenger_windows[window] != 0)
+        {
+            windows += stringff(" c=%u:%u", unsigned(window), unsigned(stats.pippenger_windows[window]));
+        }
+    }
+
+    if (stats.straus_calls != 0 && stats.pippenger_calls != 0)
+    {
+        std::cout << "Ok: multiexp stats, pippenger windows" << windows << ", batch affine " << stats.batch_affine_calls << std::endl;
+    }
+    else
+    {
+        std::cout << "Err: multiexp stats, straus calls " << stats.straus_calls << ", pippenger calls " << stats.pippenger_calls << std::endl;
+    }
+}
+
+// BN254 and BLS12-381 G1 multiexp vectors of a file again, with the endomorphism split enabled by the caller.
+// All points of these vectors are in the subgroup.
+void endomorphism_tests(std::string const &path, api_function runner = run)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto const first = line.find('|');
+        auto const second = line.find('|', first + 1);
+        auto const name = line.substr(0, first);
+        if ((name.rfind("BN254 G1", 0) != 0 && name.rfind("BLS12-381 G1", 0) != 0) || name.find("multiexp") == std::string::npos)
+        {
+            continue;
+        }
+        auto const output_hex = line.substr(second + 1);
+        std::optional<std::vector<std::uint8_t>> output;
+        if (!output_hex.empty())
+        {
+            output = parse_hex(output_hex);
+        }
+        api_test(parse_hex(line.substr(first + 1, second - first - 1)), output, "endomorphism " + name, runner);
+    }
+}
+
+// Vectors with enough pairs must have gone through the split
+void endomorphism_stats_test()
+{
+    auto const stats = multiexp_stats();
+    if (stats.endomorphism_calls != 0)
+    {
+        std::cout << "Ok: endomorphism split in " << stats.endomorphism_calls << " of " << stats.pippenger_calls << " pippenger calls" << std::endl;
+    }
+    else
+    {
+        std::cout << "Err: endomorphism split was not used" << std::endl;
+    }
+}
+
+// Vectors of a file through run_pairing_batch in one batch, twice each and with copies that have the last byte
+// flipped or removed, so that BN and BLS12 checks are batched with true, false and failing checks of the same curves.
+// Every result must be the one of run.
+void pairing_batch_tests(std::string const &path)
+{
+    std::vector<std::string> names;
+    std::vector<std::vector<std::uint8_t>> inputs;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        auto const first = line.find('|');
+        auto const second = line.find('|', first + 1);
+        auto const name = line.substr(0, first);
+        auto const input = parse_hex(line.substr(first + 1, second - first - 1));
+        names.push_back(name);
+        inputs.push_back(input);
+        if (input.empty())
+        {
+            continue;
+        }
+        names.push_back("repeated " + name);
+        inputs.push_back(input);
+        auto flipped = input;
+        flipped.back() ^= 1;
+        names.push_back("flipped " + name);
+        inputs.push_back(flipped);
+        names.push_back("truncated " + name);
+        inputs.emplace_back(input.cbegin(), input.cend() - 1);
+    }
+
+    auto const results = run_pairing_batch(inputs);
+    for (std::size_t i = 0; i < inputs.size(); i++)
+    {
+        if (results[i] == run(inputs[i]))
+        {
+            std::cout << "Ok: batch " << names[i] << std::endl;
+        }
+        else
+        {
+            std::cout << "Err: Batch result differs from run: " << names[i] << std::endl;
+        }
+    }
+}
+
 int main()
 {
     // // Api
@@ -182,6 +432,36 @@ int main()
     // }
     std::cout << "Starting tests" << std::endl;
     tests();
+    file_tests("test_vectors/operations.txt");
+    file_tests("test_vectors/pairings.txt");
+    // G2 points were prepared once by now, so BN and BLS12 pairings load their lines from the line cache
+    file_tests("test_vectors/pairings.txt");
+    configure_pairing_line_cache(0);
+    file_tests("test_vectors/pairings.txt");
+    configure_pairing_line_cache(16 * 1024 * 1024);
+    // Pairs split over threads, so that the 8 pair vectors run in parts
+    configure_parallel_pairing(true);
+    configure_threads(4);
+    file_tests("test_vectors/pairings.txt");
+    configure_threads(1);
+    configure_parallel_pairing(false);
+    pairing_batch_tests("test_vectors/pairings.txt");
+    // Bases are repeated by now, so this pass multiplies through fixed base tables
+    file_tests("test_vectors/operations.txt");
+    multiexp_stats_test();
+    reset_multiexp_stats();
+    configure_multiexp_endomorphism(true);
+    endomorphism_tests("test_vectors/operations.txt");
+    endomorphism_tests("test_vectors/large_multiexp.txt", run_large_multiexp);
+    configure_multiexp_endomorphism(false);
+    endomorphism_stats_test();
+    multiexp_bases_tests("test_vectors/operations.txt");
+    large_multiexp_tests("test_vectors/operations.txt");
+    file_tests("test_vectors/large_multiexp.txt", run_large_multiexp);
+    // More threads than Pippenger windows, so that large multiexps are split into point chunks as well
+    configure_threads(64);
+    file_tests("test_vectors/operations.txt");
+    configure_threads(1);
     std::cout << "Done testing" << std::endl;
 }
 
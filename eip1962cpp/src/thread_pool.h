@@ -0,0 +1,183 @@
+#ifndef H_THREAD_POOL
+#define H_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "common.h"
+
+/*
+Process wide pool of worker threads for operations that split into independent tasks.
+The pool starts with a single thread, which is the calling one, so nothing runs in parallel until threads are configured.
+Tasks must not depend on the thread they run on, results are combined by the caller in task order.
+*/
+
+class ThreadPool
+{
+    // One run call, tasks are taken by index by the workers and the calling thread
+    struct Job
+    {
+        std::function<void(usize)> const *task;
+        usize count;
+        std::atomic<usize> next;
+        std::atomic<usize> done;
+        // Workers inside execute, the job must outlive them
+        usize active;
+        std::exception_ptr error;
+        std::mutex error_mutex;
+    };
+
+    std::vector<std::thread> workers;
+    // Held by the run call that owns the workers and while threads are reconfigured
+    std::mutex run_mutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    Job *job = nullptr;
+    u64 generation = 0;
+    bool stopping = false;
+
+public:
+    static ThreadPool &getInstance()
+    {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    // Total number of threads including the calling one, at least 1
+    void set_threads(usize threads)
+    {
+        std::lock_guard<std::mutex> run_lock(run_mutex);
+        stop();
+        for (usize i = 1; i < threads; i++)
+        {
+            workers.push_back(std::thread([this]() { work(); }));
+        }
+    }
+
+    usize threads()
+    {
+        std::lock_guard<std::mutex> run_lock(run_mutex);
+        return workers.size() + 1;
+    }
+
+    // Runs task(0) .. task(count - 1) and returns when all are done, the first exception thrown by a task is rethrown.
+    // If the pool is busy with another run, e.g. a nested one, the tasks run on the calling thread.
+    void run(usize count, std::function<void(usize)> const &task)
+    {
+        std::unique_lock<std::mutex> run_lock(run_mutex, std::try_to_lock);
+        if (!run_lock.owns_lock() || workers.empty() || count <= 1)
+        {
+            for (usize i = 0; i < count; i++)
+            {
+                task(i);
+            }
+            return;
+        }
+
+        Job current;
+        current.task = &task;
+        current.count = count;
+        current.next = 0;
+        current.done = 0;
+        current.active = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &current;
+            generation++;
+        }
+        wake.notify_all();
+
+        execute(current);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&]() { return current.done == current.count && current.active == 0; });
+        job = nullptr;
+        lock.unlock();
+
+        if (current.error)
+        {
+            std::rethrow_exception(current.error);
+        }
+    }
+
+private:
+    ThreadPool() = default;
+    ~ThreadPool()
+    {
+        stop();
+    }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        workers.clear();
+        stopping = false;
+    }
+
+    void execute(Job &current)
+    {
+        for (usize i = current.next++; i < current.count; i = current.next++)
+        {
+            try
+            {
+                (*current.task)(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(current.error_mutex);
+                if (!current.error)
+                {
+                    current.error = std::current_exception();
+                }
+            }
+            if (++current.done == current.count)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+
+    void work()
+    {
+        u64 seen = 0;
+        while (true)
+        {
+            Job *current;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stopping || (job != nullptr && generation != seen); });
+                if (stopping)
+                {
+                    return;
+                }
+                seen = generation;
+                current = job;
+                current->active++;
+            }
+            execute(*current);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                current->active--;
+            }
+            finished.notify_all();
+        }
+    }
+};
+
+#endif